@@ -301,6 +301,11 @@ int App::run(int argc, char** argv)
 
     PROFILER_PRINT;
 
+    QString traceOutput = commandLine.diagnostic().traceOutput;
+    if (!traceOutput.isEmpty()) {
+        PROFILER_SAVE_TIMELINE(traceOutput.toStdString());
+    }
+
     // Wait Thread Poll
 #ifndef Q_OS_WASM
     QThreadPool* globalThreadPool = QThreadPool::globalInstance();
@@ -379,6 +384,9 @@ int App::processConverter(const CommandLineController::ConverterTask& task)
         std::string scoreSource = task.params[CommandLineController::ParamKey::ScoreSource].toString().toStdString();
         ret = converter()->updateSource(task.inputFile, scoreSource, forceMode);
     } break;
+    case CommandLineController::ConvertType::UpdateThumbnails:
+        ret = converter()->updateThumbnails(task.inputFile, forceMode);
+        break;
     }
 
     if (!ret) {
@@ -73,6 +73,9 @@ void CommandLineController::parse(const QStringList& args)
                                           "Transpose the given score and export the data to a single JSON file, print it to stdout",
                                           "options"));
     m_parser.addOption(QCommandLineOption("source-update", "Update the source in the given score"));
+    m_parser.addOption(QCommandLineOption("update-thumbnails",
+                                          "Render the thumbnails of all scores in the given directory into the thumbnail cache, "
+                                          "without saving the scores", "dir"));
 
     m_parser.addOption(QCommandLineOption({ "S", "style" }, "Load style file", "style"));
 
@@ -102,6 +105,9 @@ void CommandLineController::parse(const QStringList& args)
     m_parser.addOption(QCommandLineOption("diagnostic-com-drawdata", "Compare engraving draw data"));
     m_parser.addOption(QCommandLineOption("diagnostic-drawdata-to-png", "Convert draw data to png", "file"));
     m_parser.addOption(QCommandLineOption("diagnostic-drawdiff-to-png", "Convert draw diff to png"));
+    m_parser.addOption(QCommandLineOption("diagnostic-trace-output",
+                                          "Record a timeline of traced functions and save it on exit to 'file' as Chrome trace JSON",
+                                          "file"));
 
     // Autobot
     m_parser.addOption(QCommandLineOption("test-case", "Run test case by name or file", "nameOrFile"));
@@ -278,6 +284,12 @@ void CommandLineController::apply()
         }
     }
 
+    if (m_parser.isSet("update-thumbnails")) {
+        application()->setRunMode(IApplication::RunMode::Converter);
+        m_converterTask.type = ConvertType::UpdateThumbnails;
+        m_converterTask.inputFile = m_parser.value("update-thumbnails");
+    }
+
     // Video
 #ifdef MUE_BUILD_VIDEOEXPORT_MODULE
     if (m_parser.isSet("score-video")) {
@@ -413,6 +425,11 @@ void CommandLineController::apply()
         m_diagnostic.input = scorefiles;
     }
 
+    if (m_parser.isSet("diagnostic-trace-output")) {
+        m_diagnostic.traceOutput = m_parser.value("diagnostic-trace-output");
+        haw::profiler::Profiler::instance()->setTimelineEnabled(true);
+    }
+
     // Autobot
     if (m_parser.isSet("test-case")) {
         application()->setRunMode(IApplication::RunMode::Converter);
@@ -66,6 +66,7 @@ public:
         ExportScorePartsPdf,
         ExportScoreTranspose,
         SourceUpdate,
+        UpdateThumbnails,
         ExportScoreVideo
     };
 
@@ -100,6 +101,7 @@ public:
         DiagnosticType type = DiagnosticType::Undefined;
         QStringList input;
         QString output;
+        QString traceOutput;
     };
 
     struct Autobot {
@@ -54,6 +54,8 @@ public:
     virtual Ret exportScoreVideo(const io::path_t& in, const io::path_t& out) = 0;
 
     virtual Ret updateSource(const io::path_t& in, const std::string& newSource, bool forceMode = false) = 0;
+
+    virtual Ret updateThumbnails(const io::path_t& dir, bool forceMode = false) = 0;
 };
 }
 
@@ -359,3 +359,44 @@ mu::Ret ConverterController::updateSource(const io::path_t& in, const std::strin
 
     return BackendApi::updateSource(in, newSource, forceMode);
 }
+
+mu::Ret ConverterController::updateThumbnails(const io::path_t& dir, bool forceMode)
+{
+    TRACEFUNC;
+
+    RetVal<io::paths_t> files = fileSystem()->scanFiles(dir, { "*.mscz", "*.mscx" }, io::ScanMode::FilesInCurrentDirAndSubdirs);
+    if (!files.ret) {
+        LOGE() << "failed scan dir, err: " << files.ret.toString() << ", path: " << dir;
+        return make_ret(Err::InFileFailedLoad);
+    }
+
+    Ret result = make_ret(Ret::Code::Ok);
+
+    //! NOTE The scores themselves are never saved, only the thumbnail cache is updated
+    for (const io::path_t& file : files.val) {
+        LOGI() << "update thumbnail: " << file;
+
+        auto notationProject = notationCreator()->newProject();
+        IF_ASSERT_FAILED(notationProject) {
+            return make_ret(Err::UnknownError);
+        }
+
+        Ret ret = notationProject->load(file, io::path_t(), forceMode);
+        if (!ret) {
+            LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << file;
+            result = make_ret(Err::InFileFailedLoad);
+            continue;
+        }
+
+        engraving::MasterScore* masterScore = notationProject->masterNotation()->masterScore();
+        masterScore->updateThumbnail();
+
+        ret = thumbnailCache()->setThumbnail(file, masterScore->thumbnail());
+        if (!ret) {
+            LOGE() << "failed write thumbnail, err: " << ret.toString() << ", path: " << file;
+            result = make_ret(Err::OutFileFailedWrite);
+        }
+    }
+
+    return result;
+}
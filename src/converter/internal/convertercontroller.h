@@ -30,6 +30,8 @@
 #include "project/iprojectcreator.h"
 #include "project/inotationwritersregister.h"
 #include "project/iprojectrwregister.h"
+#include "project/iprojectthumbnailcache.h"
+#include "io/ifilesystem.h"
 #include "context/iglobalcontext.h"
 
 #include "types/retval.h"
@@ -41,6 +43,8 @@ class ConverterController : public IConverterController
     INJECT(converter, project::INotationWritersRegister, writers)
     INJECT(converter, project::IProjectRWRegister, projectRW)
     INJECT(converter, context::IGlobalContext, globalContext)
+    INJECT(converter, project::IProjectThumbnailCache, thumbnailCache)
+    INJECT(converter, io::IFileSystem, fileSystem)
 
 public:
     ConverterController() = default;
@@ -67,6 +71,8 @@ public:
 
     Ret updateSource(const io::path_t& in, const std::string& newSource, bool forceMode = false) override;
 
+    Ret updateThumbnails(const io::path_t& dir, bool forceMode = false) override;
+
 private:
 
     struct Job {
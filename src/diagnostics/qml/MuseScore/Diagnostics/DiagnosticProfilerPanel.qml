@@ -86,6 +86,20 @@ Rectangle {
                 text: "Print"
                 onClicked: profModel.print()
             }
+
+            CheckBox {
+                anchors.verticalCenter: parent.verticalCenter
+                text: "Timeline"
+                checked: profModel.timelineEnabled
+                onClicked: profModel.timelineEnabled = !checked
+            }
+
+            FlatButton {
+                anchors.verticalCenter: parent.verticalCenter
+                text: "Save timeline"
+                enabled: profModel.timelineEnabled
+                onClicked: profModel.saveTimeline()
+            }
         }
     }
 
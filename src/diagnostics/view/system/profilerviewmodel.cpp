@@ -121,3 +121,31 @@ void ProfilerViewModel::print()
 {
     PROFILER_PRINT;
 }
+
+bool ProfilerViewModel::timelineEnabled() const
+{
+    return Profiler::timelineEnabled();
+}
+
+void ProfilerViewModel::setTimelineEnabled(bool arg)
+{
+    if (timelineEnabled() == arg) {
+        return;
+    }
+
+    Profiler::instance()->setTimelineEnabled(arg);
+    emit timelineEnabledChanged();
+}
+
+void ProfilerViewModel::saveTimeline()
+{
+    std::vector<std::string> filter { "Chrome trace (*.json)" };
+    mu::io::path_t path = interactive()->selectSavingFile("Save timeline", "profiler_timeline.json", filter);
+    if (path.empty()) {
+        return;
+    }
+
+    if (!Profiler::instance()->saveTimeline(path.toStdString())) {
+        LOGE() << "failed save timeline to: " << path;
+    }
+}
@@ -24,10 +24,18 @@
 
 #include <QAbstractListModel>
 
+#include "modularity/ioc.h"
+#include "iinteractive.h"
+
 namespace mu::diagnostics {
 class ProfilerViewModel : public QAbstractListModel
 {
     Q_OBJECT
+
+    Q_PROPERTY(bool timelineEnabled READ timelineEnabled WRITE setTimelineEnabled NOTIFY timelineEnabledChanged)
+
+    INJECT(diagnostics, framework::IInteractive, interactive)
+
 public:
     explicit ProfilerViewModel(QObject* parent = 0);
 
@@ -39,6 +47,13 @@ public:
     Q_INVOKABLE void find(const QString& str);
     Q_INVOKABLE void clear();
     Q_INVOKABLE void print();
+    Q_INVOKABLE void saveTimeline();
+
+    bool timelineEnabled() const;
+    void setTimelineEnabled(bool arg);
+
+signals:
+    void timelineEnabledChanged();
 
 private:
 
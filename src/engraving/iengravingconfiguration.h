@@ -42,6 +42,9 @@ public:
 
     virtual io::path_t appDataPath() const = 0;
 
+    //! NOTE Writable dir for the precomputed symbol metrics of the engraving fonts, empty to disable the cache
+    virtual io::path_t engravingFontsCachePath() const = 0;
+
     virtual io::path_t defaultStyleFilePath() const = 0;
     virtual void setDefaultStyleFilePath(const io::path_t& path) = 0;
 
@@ -92,6 +95,11 @@ public:
 
     virtual bool isAccessibleEnabled() const = 0;
 
+    //! NOTE 0 means no limit
+    virtual size_t undoHistoryMaxSteps() const = 0;
+    virtual size_t undoHistoryMaxMemoryUsage() const = 0;
+    virtual async::Notification undoHistoryLimitsChanged() const = 0;
+
     /// these configurations will be removed after solving https://github.com/musescore/MuseScore/issues/14294
     virtual bool guitarProImportExperimental() const = 0;
     virtual bool negativeFretsAllowed() const = 0;
@@ -69,11 +69,23 @@ const MscWriter::Params& MscWriter::params() const
 
 bool MscWriter::open()
 {
+    if (m_params.deferred) {
+        m_deferredOpened = true;
+        return true;
+    }
+
     return writer()->open(m_params.device, m_params.filePath);
 }
 
 void MscWriter::close()
 {
+    if (m_params.deferred) {
+        //! NOTE Not committed, nothing is written
+        m_deferredFiles.clear();
+        m_deferredOpened = false;
+        return;
+    }
+
     if (m_writer) {
         writeMeta();
 
@@ -86,9 +98,45 @@ void MscWriter::close()
 
 bool MscWriter::isOpened() const
 {
+    if (m_params.deferred) {
+        return m_deferredOpened;
+    }
+
     return m_writer ? m_writer->isOpened() : false;
 }
 
+bool MscWriter::commit()
+{
+    IF_ASSERT_FAILED(m_params.deferred && m_deferredOpened) {
+        return false;
+    }
+
+    writeMeta();
+
+    std::vector<std::pair<String, ByteArray> > files;
+    files.swap(m_deferredFiles);
+    m_deferredOpened = false;
+    m_params.deferred = false;
+
+    if (!writer()->open(m_params.device, m_params.filePath)) {
+        LOGE() << "failed open writer: " << m_params.filePath;
+        return false;
+    }
+
+    bool ok = true;
+    for (const auto& file : files) {
+        if (!writer()->addFileData(file.first, file.second)) {
+            LOGE() << "failed write file: " << file.first;
+            ok = false;
+            break;
+        }
+    }
+
+    close();
+
+    return ok;
+}
+
 MscWriter::IWriter* MscWriter::writer() const
 {
     if (!m_writer) {
@@ -113,6 +161,12 @@ MscWriter::IWriter* MscWriter::writer() const
 
 bool MscWriter::addFileData(const String& fileName, const ByteArray& data)
 {
+    if (m_params.deferred) {
+        m_deferredFiles.push_back({ fileName, data });
+        m_meta.addFile(fileName);
+        return true;
+    }
+
     if (!writer()->addFileData(fileName, data)) {
         LOGE() << "failed write file: " << fileName;
         return false;
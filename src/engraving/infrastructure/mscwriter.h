@@ -43,6 +43,10 @@ public:
         io::path_t filePath;
         String mainFileName;
         MscIoMode mode = MscIoMode::Zip;
+
+        //! NOTE Files are only collected in memory until commit(),
+        //! so the compression and disk IO can run on another thread
+        bool deferred = false;
     };
 
     MscWriter() = default;
@@ -56,6 +60,9 @@ public:
     void close();
     bool isOpened() const;
 
+    //! write the collected files of a deferred writer and close it
+    bool commit();
+
     void writeStyleFile(const ByteArray& data);
     void writeScoreFile(const ByteArray& data);
     void addExcerptStyleFile(const String& name, const ByteArray& data);
@@ -135,6 +142,9 @@ private:
     Params m_params;
     mutable IWriter* m_writer = nullptr;
     Meta m_meta;
+
+    bool m_deferredOpened = false;
+    std::vector<std::pair<String, ByteArray> > m_deferredFiles;
 };
 }
 
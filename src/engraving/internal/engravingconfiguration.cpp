@@ -43,6 +43,9 @@ static const Settings::Key PART_STYLE_FILE_PATH("engraving", "engraving/style/pa
 
 static const Settings::Key INVERT_SCORE_COLOR("engraving", "engraving/scoreColorInversion");
 
+static const Settings::Key UNDO_HISTORY_MAX_STEPS("engraving", "engraving/undo/maxSteps");
+static const Settings::Key UNDO_HISTORY_MAX_MEMORY_MB("engraving", "engraving/undo/maxMemoryMB");
+
 struct VoiceColorKey {
     Settings::Key key;
     Color color;
@@ -60,6 +63,17 @@ void EngravingConfiguration::init()
     };
 
     settings()->setDefaultValue(INVERT_SCORE_COLOR, Val(false));
+
+    settings()->setDefaultValue(UNDO_HISTORY_MAX_STEPS, Val(0));
+    settings()->setCanBeManuallyEdited(UNDO_HISTORY_MAX_STEPS, true);
+    settings()->setDefaultValue(UNDO_HISTORY_MAX_MEMORY_MB, Val(512));
+    settings()->setCanBeManuallyEdited(UNDO_HISTORY_MAX_MEMORY_MB, true);
+    settings()->valueChanged(UNDO_HISTORY_MAX_STEPS).onReceive(this, [this](const Val&) {
+        m_undoHistoryLimitsChanged.notify();
+    });
+    settings()->valueChanged(UNDO_HISTORY_MAX_MEMORY_MB).onReceive(this, [this](const Val&) {
+        m_undoHistoryLimitsChanged.notify();
+    });
     settings()->valueChanged(INVERT_SCORE_COLOR).onReceive(nullptr, [this](const Val&) {
         m_scoreInversionChanged.notify();
     });
@@ -85,6 +99,11 @@ mu::io::path_t EngravingConfiguration::appDataPath() const
     return globalConfiguration()->appDataPath();
 }
 
+mu::io::path_t EngravingConfiguration::engravingFontsCachePath() const
+{
+    return globalConfiguration()->userAppDataPath() + "/engraving_fonts_cache";
+}
+
 mu::io::path_t EngravingConfiguration::defaultStyleFilePath() const
 {
     return settings()->value(DEFAULT_STYLE_FILE_PATH).toPath();
@@ -276,6 +295,21 @@ bool EngravingConfiguration::isAccessibleEnabled() const
     return accessibilityConfiguration() ? accessibilityConfiguration()->enabled() : false;
 }
 
+size_t EngravingConfiguration::undoHistoryMaxSteps() const
+{
+    return static_cast<size_t>(std::max(settings()->value(UNDO_HISTORY_MAX_STEPS).toInt(), 0));
+}
+
+size_t EngravingConfiguration::undoHistoryMaxMemoryUsage() const
+{
+    return static_cast<size_t>(std::max(settings()->value(UNDO_HISTORY_MAX_MEMORY_MB).toInt(), 0)) * 1024 * 1024;
+}
+
+mu::async::Notification EngravingConfiguration::undoHistoryLimitsChanged() const
+{
+    return m_undoHistoryLimitsChanged;
+}
+
 bool EngravingConfiguration::guitarProImportExperimental() const
 {
     return guitarProConfiguration() ? guitarProConfiguration()->experimental() : false;
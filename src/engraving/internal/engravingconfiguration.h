@@ -47,6 +47,8 @@ public:
 
     io::path_t appDataPath() const override;
 
+    io::path_t engravingFontsCachePath() const override;
+
     io::path_t defaultStyleFilePath() const override;
     void setDefaultStyleFilePath(const io::path_t& path) override;
 
@@ -88,6 +90,10 @@ public:
 
     bool isAccessibleEnabled() const override;
 
+    size_t undoHistoryMaxSteps() const override;
+    size_t undoHistoryMaxMemoryUsage() const override;
+    async::Notification undoHistoryLimitsChanged() const override;
+
     bool guitarProImportExperimental() const override;
     bool negativeFretsAllowed() const override;
     bool tablatureParenthesesZIndexWorkaround() const override;
@@ -100,6 +106,7 @@ public:
 private:
     async::Channel<voice_idx_t, draw::Color> m_voiceColorChanged;
     async::Notification m_scoreInversionChanged;
+    async::Notification m_undoHistoryLimitsChanged;
 
     ValNt<DebuggingOptions> m_debuggingOptions;
 
@@ -21,6 +21,8 @@
  */
 #include "engravingfont.h"
 
+#include <cstring>
+
 #include "serialization/json.h"
 #include "io/file.h"
 #include "io/fileinfo.h"
@@ -38,6 +40,72 @@ using namespace mu::io;
 using namespace mu::draw;
 using namespace mu::engraving;
 
+//! NOTE Symbol metrics are measured with FreeType and read from metadata.json on every start,
+//! which is slow. So they are stored in a binary file, as a header followed by fixed size records,
+//! and reused while the font, its metadata and the symbol list stay the same
+static constexpr char METRICS_CACHE_MAGIC[4] = { 'M', 'S', 'F', 'M' };
+
+//! NOTE Must be increased when the records change, or when the symbol metrics are measured differently:
+//! FontEngineFT, DPI, the Smufl anchor and engraving defaults tables. As this is easy to miss,
+//! the application version and revision are part of the hash as well
+static constexpr uint32_t METRICS_CACHE_VERSION = 2;
+static constexpr size_t SMUFL_ANCHORS_COUNT = static_cast<size_t>(SmuflAnchorId::opticalCenter) + 1;
+
+struct MetricsCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t hash;
+    uint32_t symbolsCount;
+    uint32_t engravingDefaultsCount;
+    double textEnclosureThickness;
+};
+
+struct MetricsCacheSymbol {
+    uint32_t code;
+    uint32_t anchorsMask;
+    double bbox[4];
+    double advance;
+    double anchors[SMUFL_ANCHORS_COUNT][2];
+};
+
+struct MetricsCacheEngravingDefault {
+    int32_t sid;
+    uint32_t isBool;
+    double value;
+};
+
+static void hashBytes(uint64_t& hash, const uint8_t* data, size_t size)
+{
+    // FNV-1a
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+}
+
+static uint64_t metricsCacheHash(const ByteArray& fontData, const ByteArray& metadata)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    hashBytes(hash, fontData.constData(), fontData.size());
+    hashBytes(hash, metadata.constData(), metadata.size());
+
+    //! NOTE Symbols are stored by SymId, so the cache must be rebuilt when the list of symbols changes
+    for (size_t id = 0; id <= static_cast<size_t>(SymId::lastSym); ++id) {
+        AsciiStringView name = SymNames::nameForSymId(static_cast<SymId>(id));
+        hashBytes(hash, reinterpret_cast<const uint8_t*>(name.ascii()), name.size());
+    }
+
+    static constexpr const char* BUILD_ID[] = { MUSESCORE_VERSION, MUSESCORE_REVISION };
+    for (const char* str : BUILD_ID) {
+        hashBytes(hash, reinterpret_cast<const uint8_t*>(str), std::strlen(str));
+    }
+
+    double dpi = DPI;
+    hashBytes(hash, reinterpret_cast<const uint8_t*>(&dpi), sizeof(dpi));
+
+    return hash;
+}
+
 // =============================================
 // ScoreFont
 // =============================================
@@ -104,6 +172,22 @@ void EngravingFont::ensureLoad()
     m_font.setNoFontMerging(true);
     m_font.setHinting(mu::draw::Font::Hinting::PreferVerticalHinting);
 
+    ByteArray fontData;
+    ByteArray metadata;
+    io::path_t metadataPath = io::FileInfo(m_fontPath).path() + u"/metadata.json";
+    bool metadataOk = File::readFile(metadataPath, metadata);
+
+    io::path_t cachePath = metricsCacheFilePath();
+    uint64_t hash = 0;
+    if (metadataOk && !cachePath.empty() && File::readFile(m_fontPath, fontData)) {
+        hash = metricsCacheHash(fontData, metadata);
+        if (loadMetricsCache(cachePath, hash)) {
+            loadComposedGlyphs();
+            m_loaded = true;
+            return;
+        }
+    }
+
     for (size_t id = 0; id < m_symbols.size(); ++id) {
         Smufl::Code code = Smufl::code(static_cast<SymId>(id));
         if (!code.isValid()) {
@@ -113,27 +197,186 @@ void EngravingFont::ensureLoad()
         computeMetrics(sym, code);
     }
 
-    File metadataFile(io::FileInfo(m_fontPath).path() + u"/metadata.json");
-    if (!metadataFile.open(IODevice::ReadOnly)) {
-        LOGE() << "Failed to open glyph metadata file: " << metadataFile.filePath();
+    if (!metadataOk) {
+        LOGE() << "Failed to open glyph metadata file: " << metadataPath;
         return;
     }
 
     std::string error;
-    JsonObject metadataJson = JsonDocument::fromJson(metadataFile.readAll(), &error).rootObject();
+    JsonObject metadataJson = JsonDocument::fromJson(metadata, &error).rootObject();
     if (!error.empty()) {
-        LOGE() << "Json parse error in " << metadataFile.filePath() << ", error: " << error;
+        LOGE() << "Json parse error in " << metadataPath << ", error: " << error;
         return;
     }
 
     loadGlyphsWithAnchors(metadataJson.value("glyphsWithAnchors").toObject());
-    loadComposedGlyphs();
     loadStylisticAlternates(metadataJson.value("glyphsWithAlternates").toObject());
     loadEngravingDefaults(metadataJson.value("engravingDefaults").toObject());
 
+    if (!fontData.empty()) {
+        saveMetricsCache(cachePath, hash);
+    }
+
+    loadComposedGlyphs();
+
     m_loaded = true;
 }
 
+io::path_t EngravingFont::metricsCacheFilePath() const
+{
+    if (!configuration()) {
+        return io::path_t();
+    }
+
+    io::path_t dir = configuration()->engravingFontsCachePath();
+    if (dir.empty()) {
+        return io::path_t();
+    }
+
+    return dir + "/" + m_name.c_str() + ".metrics";
+}
+
+bool EngravingFont::loadMetricsCache(const io::path_t& cachePath, uint64_t hash)
+{
+    TRACEFUNC;
+
+    ByteArray data;
+    if (!File::exists(cachePath) || !File::readFile(cachePath, data)) {
+        return false;
+    }
+
+    if (data.size() < sizeof(MetricsCacheHeader)) {
+        return false;
+    }
+
+    MetricsCacheHeader header;
+    std::memcpy(&header, data.constData(), sizeof(header));
+    if (std::memcmp(header.magic, METRICS_CACHE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != METRICS_CACHE_VERSION
+        || header.hash != hash
+        || header.symbolsCount != m_symbols.size()) {
+        return false;
+    }
+
+    size_t expectedSize = sizeof(MetricsCacheHeader)
+                          + header.symbolsCount * sizeof(MetricsCacheSymbol)
+                          + header.engravingDefaultsCount * sizeof(MetricsCacheEngravingDefault);
+    if (data.size() != expectedSize) {
+        LOGW() << "Corrupted engraving font metrics cache: " << cachePath;
+        return false;
+    }
+
+    const uint8_t* ptr = data.constData() + sizeof(MetricsCacheHeader);
+    for (Sym& sym : m_symbols) {
+        MetricsCacheSymbol record;
+        std::memcpy(&record, ptr, sizeof(record));
+        ptr += sizeof(record);
+
+        sym.code = record.code;
+        sym.bbox = RectF(record.bbox[0], record.bbox[1], record.bbox[2], record.bbox[3]);
+        sym.advance = record.advance;
+        sym.smuflAnchors.clear();
+        for (size_t i = 0; i < SMUFL_ANCHORS_COUNT; ++i) {
+            if (record.anchorsMask & (1u << i)) {
+                sym.smuflAnchors[static_cast<SmuflAnchorId>(i)] = PointF(record.anchors[i][0], record.anchors[i][1]);
+            }
+        }
+    }
+
+    m_engravingDefaults.clear();
+    for (uint32_t i = 0; i < header.engravingDefaultsCount; ++i) {
+        MetricsCacheEngravingDefault record;
+        std::memcpy(&record, ptr, sizeof(record));
+        ptr += sizeof(record);
+
+        Sid sid = static_cast<Sid>(record.sid);
+        if (record.isBool) {
+            m_engravingDefaults.insert({ sid, record.value != 0.0 });
+        } else {
+            m_engravingDefaults.insert({ sid, record.value });
+        }
+    }
+
+    m_engravingDefaults.insert({ Sid::MusicalTextFont, String(u"%1 Text").arg(String::fromStdString(m_family)) });
+    m_textEnclosureThickness = header.textEnclosureThickness;
+
+    return true;
+}
+
+void EngravingFont::saveMetricsCache(const io::path_t& cachePath, uint64_t hash) const
+{
+    TRACEFUNC;
+
+    std::vector<MetricsCacheEngravingDefault> defaults;
+    for (const auto& pair : m_engravingDefaults) {
+        MetricsCacheEngravingDefault record;
+        record.sid = static_cast<int32_t>(pair.first);
+        switch (pair.second.type()) {
+        case P_TYPE::BOOL:
+            record.isBool = 1;
+            record.value = pair.second.toBool() ? 1.0 : 0.0;
+            break;
+        case P_TYPE::REAL:
+            record.isBool = 0;
+            record.value = pair.second.toDouble();
+            break;
+        default:
+            //! NOTE MusicalTextFont is derived from the family name, not stored
+            continue;
+        }
+        defaults.push_back(record);
+    }
+
+    MetricsCacheHeader header;
+    std::memcpy(header.magic, METRICS_CACHE_MAGIC, sizeof(header.magic));
+    header.version = METRICS_CACHE_VERSION;
+    header.hash = hash;
+    header.symbolsCount = static_cast<uint32_t>(m_symbols.size());
+    header.engravingDefaultsCount = static_cast<uint32_t>(defaults.size());
+    header.textEnclosureThickness = m_textEnclosureThickness;
+
+    ByteArray data(sizeof(MetricsCacheHeader)
+                   + m_symbols.size() * sizeof(MetricsCacheSymbol)
+                   + defaults.size() * sizeof(MetricsCacheEngravingDefault));
+
+    uint8_t* ptr = data.data();
+    std::memcpy(ptr, &header, sizeof(header));
+    ptr += sizeof(header);
+
+    for (const Sym& sym : m_symbols) {
+        MetricsCacheSymbol record {};
+        record.code = sym.code;
+        record.bbox[0] = sym.bbox.x();
+        record.bbox[1] = sym.bbox.y();
+        record.bbox[2] = sym.bbox.width();
+        record.bbox[3] = sym.bbox.height();
+        record.advance = sym.advance;
+        for (const auto& anchor : sym.smuflAnchors) {
+            size_t i = static_cast<size_t>(anchor.first);
+            record.anchorsMask |= (1u << i);
+            record.anchors[i][0] = anchor.second.x();
+            record.anchors[i][1] = anchor.second.y();
+        }
+
+        std::memcpy(ptr, &record, sizeof(record));
+        ptr += sizeof(record);
+    }
+
+    for (const MetricsCacheEngravingDefault& record : defaults) {
+        std::memcpy(ptr, &record, sizeof(record));
+        ptr += sizeof(record);
+    }
+
+    Ret ret = fileSystem()->makePath(io::FileInfo(cachePath).path());
+    if (ret) {
+        ret = File::writeFile(cachePath, data);
+    }
+
+    if (!ret) {
+        LOGW() << "Failed to write engraving font metrics cache: " << cachePath << ", err: " << ret.toString();
+    }
+}
+
 void EngravingFont::loadGlyphsWithAnchors(const JsonObject& glyphsWithAnchors)
 {
     for (const std::string& symName : glyphsWithAnchors.keys()) {
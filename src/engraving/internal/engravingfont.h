@@ -30,8 +30,10 @@
 #include "draw/ifontprovider.h"
 #include "draw/types/geometry.h"
 #include "iengravingfontsprovider.h"
+#include "iengravingconfiguration.h"
 
 #include "io/path.h"
+#include "io/ifilesystem.h"
 
 #include "smufl.h"
 
@@ -51,6 +53,8 @@ class EngravingFont : public IEngravingFont
 {
     INJECT_STATIC(score, mu::draw::IFontProvider, fontProvider)
     INJECT_STATIC(score, IEngravingFontsProvider, engravingFonts)
+    INJECT_STATIC(score, IEngravingConfiguration, configuration)
+    INJECT_STATIC(score, io::IFileSystem, fileSystem)
 public:
     EngravingFont(const std::string& name, const std::string& family, const io::path_t& filePath);
     EngravingFont(const EngravingFont& other);
@@ -117,6 +121,10 @@ private:
     void loadEngravingDefaults(const JsonObject& engravingDefaultsObject);
     void computeMetrics(Sym& sym, const Smufl::Code& code);
 
+    io::path_t metricsCacheFilePath() const;
+    bool loadMetricsCache(const io::path_t& cachePath, uint64_t hash);
+    void saveMetricsCache(const io::path_t& cachePath, uint64_t hash) const;
+
     Sym& sym(SymId id);
     const Sym& sym(SymId id) const;
 
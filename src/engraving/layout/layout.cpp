@@ -71,6 +71,29 @@ Layout::Layout(Score* score)
 {
 }
 
+//! NOTE Measures keep their horizontal spacing between layouts (see Measure::computeWidth),
+//! so it has to be dropped for the measures whose contents may have changed. Neighbours are
+//! included for elements reaching across the barline, like ties and beams
+void Layout::invalidateSpacing(bool layoutAll, const Fraction& stick, const Fraction& etick)
+{
+    Measure* m = layoutAll ? nullptr : m_score->tick2measure(stick);
+    if (!m) {
+        m = m_score->firstMeasure();
+    } else if (m->prevMeasure()) {
+        m = m->prevMeasure();
+    }
+
+    for (; m; m = m->nextMeasure()) {
+        m->invalidateSpacing();
+        if (m->mmRest()) {
+            m->mmRest()->invalidateSpacing();
+        }
+        if (!layoutAll && m->tick() > etick) {
+            break;
+        }
+    }
+}
+
 void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, const Fraction& et)
 {
     CmdStateLocker cmdStateLocker(m_score);
@@ -100,6 +123,8 @@ void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, con
 
     ctx.endTick = etick;
 
+    invalidateSpacing(layoutAll, stick, etick);
+
     if (m_score->cmdState().layoutFlags & LayoutFlag::REBUILD_MIDI_MAPPING) {
         if (m_score->isMaster()) {
             m_score->masterScore()->rebuildMidiMapping();
@@ -37,6 +37,8 @@ public:
 
 private:
 
+    void invalidateSpacing(bool layoutAll, const Fraction& stick, const Fraction& etick);
+
     void layoutLinear(const LayoutOptions& options, LayoutContext& ctx);
     void layoutLinear(bool layoutAll, const LayoutOptions& options, LayoutContext& lc);
     void resetSystems(bool layoutAll, const LayoutOptions& options, LayoutContext& lc);
@@ -108,7 +108,7 @@ bool LayoutBeams::notTopBeam(ChordRest* cr)
 void LayoutBeams::restoreBeams(Measure* m)
 {
     for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
-        for (EngravingItem* e : s->elist()) {
+        for (EngravingItem* e : s->elements()) {
             if (e && e->isChordRest()) {
                 ChordRest* cr = toChordRest(e);
                 Beam* b = cr->beam();
@@ -482,7 +482,7 @@ void LayoutBeams::createBeams(Score* score, LayoutContext& lc, Measure* measure)
 
 void LayoutBeams::layoutNonCrossBeams(Segment* s)
 {
-    for (EngravingItem* e : s->elist()) {
+    for (EngravingItem* e : s->elements()) {
         if (!e || !e->isChordRest() || !e->score()->staff(e->staffIdx())->show()) {
             // the beam and its system may still be referenced when selecting all,
             // even if the staff is invisible. The old system is invalid and does cause problems in #284012
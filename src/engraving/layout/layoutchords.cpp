@@ -1231,6 +1231,9 @@ void LayoutChords::updateGraceNotes(Measure* measure)
     Score* score = measure->score();
     // Clean everything
     for (Segment& s : measure->segments()) {
+        if (!s.hasPreAppendedItems()) {
+            continue;
+        }
         for (unsigned track = 0; track < score->staves().size() * VOICES; ++track) {
             EngravingItem* e = s.preAppendedItem(track);
             if (e && e->isGraceNotesGroup()) {
@@ -1244,7 +1247,7 @@ void LayoutChords::updateGraceNotes(Measure* measure)
         if (!s.isChordRestType()) {
             continue;
         }
-        for (auto el : s.elist()) {
+        for (EngravingItem* el : s.elements()) {
             if (el && el->isChord() && !toChord(el)->graceNotes().empty()) {
                 appendGraceNotes(toChord(el));
             }
@@ -1252,6 +1255,9 @@ void LayoutChords::updateGraceNotes(Measure* measure)
     }
     // Layout grace note groups
     for (Segment& s : measure->segments()) {
+        if (!s.hasPreAppendedItems()) {
+            continue;
+        }
         for (unsigned track = 0; track < score->staves().size() * VOICES; ++track) {
             EngravingItem* e = s.preAppendedItem(track);
             if (e && e->isGraceNotesGroup()) {
@@ -1305,6 +1311,10 @@ void LayoutChords::appendGraceNotes(Chord* chord)
 *  is needed and must be called AFTER horizontal spacing is calculated. */
 void LayoutChords::repositionGraceNotesAfter(Segment* segment)
 {
+    if (!segment->hasPreAppendedItems()) {
+        return;
+    }
+
     size_t tracks = segment->score()->staves().size() * VOICES;
     for (size_t track = 0; track < tracks; track++) {
         EngravingItem* item = segment->preAppendedItem(static_cast<int>(track));
@@ -1326,7 +1336,7 @@ void LayoutChords::clearLineAttachPoints(Measure* measure)
         if (!s.isChordRestType()) {
             continue;
         }
-        for (EngravingItem* e : s.elist()) {
+        for (EngravingItem* e : s.elements()) {
             if (!e || !e->isChord()) {
                 continue;
             }
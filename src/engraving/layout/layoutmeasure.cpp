@@ -853,7 +853,7 @@ void LayoutMeasure::getNextMeasure(const LayoutOptions& options, LayoutContext&
 
     for (Segment& segment : measure->segments()) {
         if (segment.isBreathType()) {
-            for (EngravingItem* e : segment.elist()) {
+            for (EngravingItem* e : segment.elements()) {
                 if (e && e->isBreath()) {
                     e->layout();
                 }
@@ -934,7 +934,7 @@ void LayoutMeasure::computePreSpacingItems(Measure* m)
         if (!seg.isChordRestType()) {
             continue;
         }
-        for (EngravingItem* e : seg.elist()) {
+        for (EngravingItem* e : seg.elements()) {
             if (!e || !e->isChord()) {
                 continue;
             }
@@ -757,7 +757,7 @@ void LayoutSystem::layoutSystemElements(const LayoutOptions& options, LayoutCont
                 } else {
                     track_idx_t strack = staffIdx * VOICES;
                     track_idx_t etrack = strack + VOICES;
-                    for (EngravingItem* e : s.elist()) {
+                    for (EngravingItem* e : s.elements()) {
                         if (!e) {
                             continue;
                         }
@@ -820,7 +820,7 @@ void LayoutSystem::layoutSystemElements(const LayoutOptions& options, LayoutCont
 
     for (Segment* s : sl) {
         std::set<staff_idx_t> recreateShapes;
-        for (EngravingItem* e : s->elist()) {
+        for (EngravingItem* e : s->elements()) {
             if (!e || !e->isChordRest() || !score->staff(e->staffIdx())->show()) {
                 continue;
             }
@@ -880,7 +880,7 @@ void LayoutSystem::layoutSystemElements(const LayoutOptions& options, LayoutCont
     //-------------------------------------------------------------
 
     for (Segment* s : sl) {
-        for (EngravingItem* e : s->elist()) {
+        for (EngravingItem* e : s->elements()) {
             if (!e || !e->isChordRest() || !score->staff(e->staffIdx())->show()) {
                 continue;
             }
@@ -900,7 +900,7 @@ void LayoutSystem::layoutSystemElements(const LayoutOptions& options, LayoutCont
 
     std::map<track_idx_t, Fraction> skipTo;
     for (Segment* s : sl) {
-        for (EngravingItem* e : s->elist()) {
+        for (EngravingItem* e : s->elements()) {
             if (!e || !e->isChordRest() || !score->staff(e->staffIdx())->show()) {
                 continue;
             }
@@ -1269,7 +1269,7 @@ void LayoutSystem::doLayoutTies(System* system, std::vector<Segment*> sl, const
     UNUSED(etick);
 
     for (Segment* s : sl) {
-        for (EngravingItem* e : s->elist()) {
+        for (EngravingItem* e : s->elements()) {
             if (!e || !e->isChord()) {
                 continue;
             }
@@ -1435,7 +1435,7 @@ void LayoutSystem::updateCrossBeams(System* system, const LayoutContext& ctx)
             if (!seg.isChordRestType()) {
                 continue;
             }
-            for (EngravingItem* e : seg.elist()) {
+            for (EngravingItem* e : seg.elements()) {
                 if (!e || !e->isChord()) {
                     continue;
                 }
@@ -1453,7 +1453,7 @@ void LayoutSystem::updateCrossBeams(System* system, const LayoutContext& ctx)
             continue;
         }
         for (Segment& seg : toMeasure(mb)->segments()) {
-            for (EngravingItem* e : seg.elist()) {
+            for (EngravingItem* e : seg.elements()) {
                 if (!e || !e->isChord()) {
                     continue;
                 }
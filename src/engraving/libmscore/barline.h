@@ -91,6 +91,7 @@ public:
     virtual ~BarLine();
 
     KerningType doComputeKerningType(const EngravingItem*) const override { return KerningType::NON_KERNING; }
+    bool hasCustomKerning() const override { return true; }
 
     BarLine& operator=(const BarLine&) = delete;
 
@@ -65,6 +65,7 @@ private:
     bool sameVoiceKerningLimited() const override { return true; }
     bool alwaysKernable() const override { return true; }
     KerningType doComputeKerningType(const EngravingItem* nextItem) const override;
+    bool hasCustomKerning() const override { return true; }
 
 public:
 
@@ -423,6 +423,10 @@ void Score::update(bool resetCmdState, bool layoutAllParts)
         ms->deletePostponed();
 
         if (cs.layoutRange()) {
+            //! NOTE Part scores are laid out one after another on purpose: their layouts
+            //! push commands (stems, start repeats, system dividers, lyrics autoplace)
+            //! onto the master's open undo macro, register items in the shared elements
+            //! provider and use the shared symbol engines and FreeType faces of the font provider
             for (Score* s : ms->scoreList()) {
                 if (s != this && !s->isOpen() && ms->scoreList().size() > 1 && !layoutAllParts) {
                     continue;
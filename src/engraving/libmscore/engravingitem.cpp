@@ -2699,6 +2699,22 @@ String EngravingItem::formatBarsAndBeats() const
     return result;
 }
 
+HorizontalSpacingInfo EngravingItem::horizontalSpacingInfo() const
+{
+    HorizontalSpacingInfo info;
+    info.score = score();
+    info.type = type();
+    info.mag = mag();
+    info.track = track();
+    info.userSetKerning = _userSetKerning;
+    info.sameVoiceKerningLimited = sameVoiceKerningLimited();
+    info.neverKernable = neverKernable();
+    info.alwaysKernable = alwaysKernable();
+    info.customKerning = hasCustomKerning();
+    info.customPadding = hasCustomPadding();
+    return info;
+}
+
 double EngravingItem::computePadding(const EngravingItem* nextItem) const
 {
     double scaling = (mag() + nextItem->mag()) / 2;
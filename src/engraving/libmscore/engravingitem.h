@@ -116,6 +116,21 @@ enum class KerningType
     NOT_SET,
 };
 
+//! NOTE What horizontal spacing needs to know about an item to compute its padding
+//! and kerning against other items, gathered once per item instead of once per pair
+struct HorizontalSpacingInfo {
+    const Score* score = nullptr;
+    ElementType type = ElementType::INVALID;
+    double mag = 1.0;
+    track_idx_t track = mu::nidx;
+    KerningType userSetKerning = KerningType::NOT_SET;
+    bool sameVoiceKerningLimited = false;
+    bool neverKernable = false;
+    bool alwaysKernable = false;
+    bool customKerning = false;
+    bool customPadding = false;
+};
+
 class EngravingItemList : public std::list<EngravingItem*>
 {
     OBJECT_ALLOCATOR(engraving, EngravingItemList)
@@ -174,12 +189,18 @@ protected:
 
     virtual KerningType doComputeKerningType(const EngravingItem*) const { return KerningType::KERNING; }
 
+    //! NOTE Items overriding doComputeKerningType or computePadding must return true here,
+    //! otherwise horizontal spacing computes kerning and padding from HorizontalSpacingInfo only
+    virtual bool hasCustomKerning() const { return false; }
+    virtual bool hasCustomPadding() const { return false; }
+
 public:
 
     virtual ~EngravingItem();
 
     KerningType computeKerningType(const EngravingItem* nextItem) const;
     virtual double computePadding(const EngravingItem* nextItem) const;
+    HorizontalSpacingInfo horizontalSpacingInfo() const;
 
 #ifndef ENGRAVING_NO_ACCESSIBILITY
     virtual void setupAccessible();
@@ -131,6 +131,7 @@ public:
     ~Harmony();
 
     KerningType doComputeKerningType(const EngravingItem* nextItem) const override;
+    bool hasCustomKerning() const override { return true; }
 
     Harmony* clone() const override { return new Harmony(*this); }
 
@@ -22,6 +22,8 @@
 
 #include "instrtemplate.h"
 
+#include <unordered_map>
+
 #include "io/file.h"
 
 #include "containers.h"
@@ -51,6 +53,15 @@ std::vector<InstrumentGenre*> instrumentGenres;
 std::vector<InstrumentFamily*> instrumentFamilies;
 std::vector<ScoreOrder> instrumentOrders;
 
+// the first loaded template of every id: templates are looked up by id
+// for every instrument while loading, and when reading scores
+static std::unordered_map<String, InstrumentTemplate*> templatesById;
+
+static void addTemplateToIndex(InstrumentTemplate* t)
+{
+    templatesById.insert({ t->id, t });
+}
+
 //---------------------------------------------------------
 //   InstrumentIndex
 //---------------------------------------------------------
@@ -170,11 +181,13 @@ void InstrumentGroup::read(XmlReader& e)
                 instrumentTemplates.push_back(t);
             }
             t->read(e);
+            addTemplateToIndex(t);
         } else if (tag == "ref") {
             InstrumentTemplate* ttt = searchTemplate(e.readText());
             if (ttt) {
                 InstrumentTemplate* t = new InstrumentTemplate(*ttt);
                 instrumentTemplates.push_back(t);
+                addTemplateToIndex(t);
             } else {
                 LOGD("instrument reference not found <%s>", e.text().toUtf8().data());
             }
@@ -646,6 +659,7 @@ void clearInstrumentTemplates()
     }
     DeleteAll(instrumentGroups);
     instrumentGroups.clear();
+    templatesById.clear();
     DeleteAll(instrumentGenres);
     instrumentGenres.clear();
     DeleteAll(instrumentFamilies);
@@ -656,6 +670,10 @@ void clearInstrumentTemplates()
 
 //---------------------------------------------------------
 //   loadInstrumentTemplates
+//    every template is read in full: InstrumentTemplate is
+//    a struct of public members that engraving, the importers
+//    and the instrument models read through instrumentGroups
+//    directly, so there is no place to load one on demand
 //---------------------------------------------------------
 
 bool loadInstrumentTemplates(const io::path_t& instrTemplatesPath)
@@ -721,12 +739,9 @@ bool loadInstrumentTemplates(const io::path_t& instrTemplatesPath)
 
 InstrumentTemplate* searchTemplate(const String& name)
 {
-    for (InstrumentGroup* g : instrumentGroups) {
-        for (InstrumentTemplate* it : g->instrumentTemplates) {
-            if (it->id == name) {
-                return it;
-            }
-        }
+    auto it = templatesById.find(name);
+    if (it != templatesById.end()) {
+        return it->second;
     }
     return 0;
 }
@@ -39,6 +39,7 @@
 #include "repeatlist.h"
 #include "sig.h"
 #include "tempo.h"
+#include "textbase.h"
 #include "undo.h"
 
 #include "log.h"
@@ -56,8 +57,12 @@ MasterScore::MasterScore(std::weak_ptr<engraving::EngravingProject> project)
 {
     m_project = project;
     _undoStack   = new UndoStack();
+    if (configuration()) {
+        _undoStack->setLimits(configuration()->undoHistoryMaxSteps(), configuration()->undoHistoryMaxMemoryUsage());
+    }
     _tempomap    = new TempoMap;
     _sigmap      = new TimeSigMap();
+    _textShapingCache = new TextShapingCache();
     _repeatList  = new RepeatList(this);
     _repeatList2 = new RepeatList(this);
     setMasterScore(this);
@@ -107,6 +112,7 @@ MasterScore::~MasterScore()
     delete _tempomap;
     delete _undoStack;
     DeleteAll(_excerpts);
+    delete _textShapingCache;
 }
 
 //---------------------------------------------------------
@@ -153,6 +159,53 @@ void MasterScore::setAutosaveDirty(bool v)
     m_autosaveDirty = v;
 }
 
+//---------------------------------------------------------
+//   thumbnail
+//    The thumbnail shows page 1, it is kept between saves
+//    and only outdated by a layout that reaches page 1
+//---------------------------------------------------------
+
+const ByteArray& MasterScore::thumbnail() const
+{
+    return m_thumbnail;
+}
+
+void MasterScore::setThumbnail(const ByteArray& png)
+{
+    m_thumbnail = png;
+    m_thumbnailOutdated = png.empty();
+}
+
+bool MasterScore::thumbnailOutdated() const
+{
+    return m_thumbnailOutdated;
+}
+
+void MasterScore::invalidateThumbnail()
+{
+    m_thumbnailOutdated = true;
+}
+
+void MasterScore::updateThumbnail()
+{
+    TRACEFUNC;
+
+    if (pages().empty()) {
+        return;
+    }
+
+    auto pixmap = createThumbnail();
+
+    ByteArray ba;
+    Buffer b(&ba);
+    b.open(IODevice::WriteOnly);
+    imageProvider()->saveAsPng(pixmap, &b);
+
+    //! NOTE createThumbnail() may have relaid out the score, which must not count as a change
+    m_thumbnail = ba;
+    m_thumbnailOutdated = false;
+}
+
 String MasterScore::name() const
 {
     return fileInfo()->fileName(false).toString();
@@ -307,14 +360,15 @@ bool MasterScore::writeMscz(MscWriter& mscWriter, bool onlySelection, bool doCre
 
     // Write thumbnail
     {
+        //! NOTE Page 1 is only rendered again if its layout changed since the last time
         if (doCreateThumbnail && !pages().empty()) {
-            auto pixmap = createThumbnail();
+            if (m_thumbnailOutdated) {
+                updateThumbnail();
+            }
 
-            ByteArray ba;
-            Buffer b(&ba);
-            b.open(IODevice::WriteOnly);
-            imageProvider()->saveAsPng(pixmap, &b);
-            mscWriter.writeThumbnailFile(ba);
+            if (!m_thumbnail.empty()) {
+                mscWriter.writeThumbnailFile(m_thumbnail);
+            }
         }
     }
 
@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_MASTERSCORE_H
 #define MU_ENGRAVING_MASTERSCORE_H
 
+#include "types/bytearray.h"
+
 #include "infrastructure/ifileinfoprovider.h"
 
 #include "instrument.h"
@@ -50,6 +52,7 @@ class Part;
 class RepeatList;
 class Revisions;
 class TempoMap;
+class TextShapingCache;
 class TimeSigMap;
 class UndoStack;
 
@@ -81,6 +84,7 @@ class MasterScore : public Score
     UndoStack* _undoStack = nullptr;
     TimeSigMap* _sigmap;
     TempoMap* _tempomap;
+    TextShapingCache* _textShapingCache;
     RepeatList* _repeatList;
     RepeatList* _repeatList2;
     bool _expandRepeats = MScore::playRepeats;
@@ -113,6 +117,9 @@ class MasterScore : public Score
     bool m_saved { false };
     bool m_autosaveDirty { true };
 
+    ByteArray m_thumbnail;                            // PNG of page 1
+    bool m_thumbnailOutdated { true };
+
     void reorderMidiMapping();
     void rebuildExcerptsMidiMapping();
     void removeDeletedMidiMapping();
@@ -149,6 +156,7 @@ public:
     UndoStack* undoStack() const override { return _undoStack; }
     TimeSigMap* sigmap() const override { return _sigmap; }
     TempoMap* tempomap() const override { return _tempomap; }
+    TextShapingCache* textShapingCache() const { return _textShapingCache; }
     async::Channel<ScoreChangesRange> changesChannel() const override { return m_changesRangeChannel; }
 
     bool playlistDirty() const override { return _playlistDirty; }
@@ -231,6 +239,12 @@ public:
     bool autosaveDirty() const;
     void setAutosaveDirty(bool v);
 
+    const ByteArray& thumbnail() const;
+    void setThumbnail(const ByteArray& png);
+    bool thumbnailOutdated() const;
+    void invalidateThumbnail();
+    void updateThumbnail();
+
     String name() const override;
 
     Ret sanityCheck();
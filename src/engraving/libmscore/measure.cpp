@@ -29,6 +29,7 @@
 
 #include <cmath>
 
+#include "hashutils.h"
 #include "realfn.h"
 
 #include "layout/layoutchords.h"
@@ -4346,11 +4347,128 @@ void Measure::computeWidth(Fraction minTicks, Fraction maxTicks, double stretchC
 
     LayoutChords::updateGraceNotes(this);
 
+    size_t inputsHash = spacingInputsHash();
+    if (restoreSpacing(inputsHash, minTicks, maxTicks, stretchCoeff)) {
+        return;
+    }
+
     x = computeFirstSegmentXPosition(s);
     bool isSystemHeader = s->header();
 
     _squeezableSpace = 0;
     computeWidth(s, x, isSystemHeader, minTicks, maxTicks, stretchCoeff);
+
+    storeSpacing(inputsHash, minTicks, maxTicks, stretchCoeff);
+}
+
+//---------------------------------------------------------
+//   spacingInputsHash
+//    everything computeWidth depends on besides the
+//    measure contents and the style, which invalidate the
+//    memo through the layout range
+//---------------------------------------------------------
+
+static void hashSegment(size_t& seed, const Segment& s)
+{
+    hashCombine(seed, &s);
+    hashCombine(seed, static_cast<int>(s.segmentType()));
+    hashCombine(seed, s.enabled());
+    hashCombine(seed, s.visible());
+    hashCombine(seed, s.header());
+    hashCombine(seed, s.trailer());
+    hashCombine(seed, s.ticks().numerator());
+    hashCombine(seed, s.ticks().denominator());
+    hashCombine(seed, s.extraLeadingSpace().val());
+
+    // shapes change with headers, trailers, hidden staves and cross staff beams
+    for (const Shape& shape : s.shapes()) {
+        hashCombine(seed, shape.size());
+        for (const ShapeElement& e : shape) {
+            hashCombine(seed, e.x());
+            hashCombine(seed, e.y());
+            hashCombine(seed, e.width());
+            hashCombine(seed, e.height());
+            hashCombine(seed, e.toItem);
+        }
+    }
+}
+
+size_t Measure::spacingInputsHash() const
+{
+    size_t seed = 0;
+    hashCombine(seed, isFirstInSystem());
+    hashCombine(seed, spatium());
+    hashCombine(seed, userStretch());
+    hashCombine(seed, m_mmRestCount);
+
+    // the minimum measure width is limited by the system width
+    if (const System* sys = system()) {
+        hashCombine(seed, sys->width());
+        hashCombine(seed, sys->leftMargin());
+    }
+
+    for (const Segment& s : m_segments) {
+        hashSegment(seed, s);
+        hashCombine(seed, s.allElementsInvisible());
+    }
+
+    // the first segment is padded against the end barline of the previous measure
+    const MeasureBase* pmb = prev();
+    if (pmb && pmb->isMeasure()) {
+        const Measure* pm = toMeasure(pmb);
+        hashCombine(seed, pm->repeatEnd());
+        hashCombine(seed, pm->system() == system());
+        if (const Segment* ps = pm->last()) {
+            hashSegment(seed, *ps);
+        }
+    }
+
+    return seed;
+}
+
+bool Measure::restoreSpacing(size_t inputsHash, const Fraction& minTicks, const Fraction& maxTicks, double stretchCoeff)
+{
+    const SpacingMemo& memo = m_spacingMemo;
+    if (!memo.valid || memo.inputsHash != inputsHash || memo.minTicks != minTicks || memo.maxTicks != maxTicks
+        || memo.stretchCoeff != stretchCoeff || memo.segments.size() != static_cast<size_t>(m_segments.size())) {
+        return false;
+    }
+
+    size_t idx = 0;
+    for (Segment& s : m_segments) {
+        const SpacingMemo::SegmentSpacing& ss = memo.segments[idx++];
+        s.setPosX(ss.x);
+        s.setWidth(ss.width);
+        s.setWidthOffset(ss.widthOffset);
+        s.setStretch(ss.stretch);
+    }
+
+    _squeezableSpace = memo.squeezableSpace;
+    setLayoutStretch(stretchCoeff);
+    setWidth(memo.width);
+    setWidthLocked(memo.widthLocked);
+
+    return true;
+}
+
+void Measure::storeSpacing(size_t inputsHash, const Fraction& minTicks, const Fraction& maxTicks, double stretchCoeff)
+{
+    SpacingMemo& memo = m_spacingMemo;
+    memo.valid = true;
+    memo.inputsHash = inputsHash;
+    memo.minTicks = minTicks;
+    memo.maxTicks = maxTicks;
+    memo.stretchCoeff = stretchCoeff;
+
+    memo.segments.clear();
+    memo.segments.reserve(m_segments.size());
+    for (const Segment& s : m_segments) {
+        memo.segments.push_back({ s.x(), s.width(), s.widthOffset(), s.stretch() });
+    }
+
+    memo.squeezableSpace = _squeezableSpace;
+    memo.width = width();
+    memo.widthLocked = isWidthLocked();
 }
 
 double Measure::computeMinMeasureWidth() const
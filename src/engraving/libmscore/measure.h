@@ -374,7 +374,31 @@ public:
 
     void respaceSegments();
 
+    void invalidateSpacing() { m_spacingMemo.valid = false; }
+
 private:
+    //! NOTE The result of the last computeWidth, reused while the measure contents (see Layout::doLayoutRange)
+    //! and everything else the spacing depends on stay the same, e.g. when the measure just moves to another system
+    struct SpacingMemo {
+        struct SegmentSpacing {
+            double x = 0.0;
+            double width = 0.0;
+            double widthOffset = 0.0;
+            double stretch = 1.0;
+        };
+
+        bool valid = false;
+        size_t inputsHash = 0;
+        Fraction minTicks;
+        Fraction maxTicks;
+        double stretchCoeff = 0.0;
+
+        std::vector<SegmentSpacing> segments;
+        double width = 0.0;
+        double squeezableSpace = 0.0;
+        bool widthLocked = false;
+    };
+
     double _squeezableSpace = 0;
     friend class Factory;
     friend class rw::MeasureRW;
@@ -389,6 +413,10 @@ private:
     void computeWidth(Segment* s, double x, bool isSystemHeader, Fraction minTicks, Fraction maxTicks, double stretchCoeff);
     double computeMinMeasureWidth() const;
 
+    size_t spacingInputsHash() const;
+    bool restoreSpacing(size_t inputsHash, const Fraction& minTicks, const Fraction& maxTicks, double stretchCoeff);
+    void storeSpacing(size_t inputsHash, const Fraction& minTicks, const Fraction& maxTicks, double stretchCoeff);
+
     MStaff* mstaff(staff_idx_t staffIndex) const;
 
     std::vector<MStaff*> m_mstaves;
@@ -415,6 +443,8 @@ private:
 
     double m_layoutStretch = 1.0;
     bool _isWidthLocked = false;
+
+    SpacingMemo m_spacingMemo;
 };
 } // namespace mu::engraving
 #endif
@@ -282,6 +282,8 @@ public:
 
     double computePadding(const EngravingItem* nextItem) const override;
     KerningType doComputeKerningType(const EngravingItem* nextItem) const override;
+    bool hasCustomKerning() const override { return true; }
+    bool hasCustomPadding() const override { return true; }
 
     Note& operator=(const Note&) = delete;
     virtual Note* clone() const override { return new Note(*this, false); }
@@ -23,7 +23,9 @@
 #include "repeatlist.h"
 
 #include <algorithm>
+#include <limits>
 #include <list>
+#include <map>
 #include <utility> // std::pair
 
 #include "jump.h"
@@ -119,8 +121,6 @@ const std::vector<const Measure*>& RepeatSegment::measureList() const
 RepeatList::RepeatList(Score* s)
 {
     _score = s;
-    idx1  = 0;
-    idx2  = 0;
 }
 
 //---------------------------------------------------------
@@ -161,6 +161,7 @@ void RepeatList::update(bool expand)
         flatten();
     }
 
+    updateLookupTables();
     _scoreChanged = false;
 }
 
@@ -186,6 +187,72 @@ void RepeatList::updateTempo()
         utick        += s->len();
         t            += tl->tick2time(s->tick + s->len()) - ct;
     }
+
+    updateLookupTables();
+}
+
+//---------------------------------------------------------
+//   updateLookupTables
+//---------------------------------------------------------
+
+void RepeatList::updateLookupTables()
+{
+    m_uticks.clear();
+    m_utimes.clear();
+    m_tickRanges.clear();
+
+    m_uticks.reserve(size());
+    m_utimes.reserve(size());
+
+    // ticks played more than once belong to the first segment playing them
+    std::map<int, TickRange> ranges;
+
+    for (size_t i = 0; i < size(); ++i) {
+        const RepeatSegment* s = at(i);
+        m_uticks.push_back(s->utick);
+        m_utimes.push_back(s->utime);
+
+        int tick = s->tick;
+        const int endTick = s->tick + s->len();
+
+        auto it = ranges.upper_bound(tick);
+        if (it != ranges.begin()) {
+            tick = std::max(tick, std::prev(it)->second.endTick);
+        }
+
+        while (tick < endTick) {
+            int gapEnd = it == ranges.end() ? endTick : std::min(endTick, it->first);
+            if (tick < gapEnd) {
+                ranges.emplace_hint(it, tick, TickRange { tick, gapEnd, i });
+            }
+            if (it == ranges.end()) {
+                break;
+            }
+            tick = std::max(tick, it->second.endTick);
+            ++it;
+        }
+    }
+
+    m_tickRanges.reserve(ranges.size());
+    for (const auto& p : ranges) {
+        m_tickRanges.push_back(p.second);
+    }
+}
+
+//---------------------------------------------------------
+//   findSegmentIdx
+///   Index of the last segment starting at or before the given value,
+///   or nidx if the value is before the first segment
+//---------------------------------------------------------
+
+template<typename T>
+static size_t findSegmentIdx(const std::vector<T>& starts, T value)
+{
+    auto it = std::upper_bound(starts.cbegin(), starts.cend(), value);
+    if (it == starts.cbegin()) {
+        return mu::nidx;
+    }
+    return static_cast<size_t>(std::distance(starts.cbegin(), it)) - 1;
 }
 
 //---------------------------------------------------------
@@ -201,12 +268,9 @@ int RepeatList::utick2tick(int tick) const
     if (tick < 0) {
         return 0;
     }
-    unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-    for (unsigned i = ii; i < n; ++i) {
-        if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i + 1)->utick))) {
-            idx1 = i;
-            return tick - (at(i)->utick - at(i)->tick);
-        }
+    size_t i = findSegmentIdx(m_uticks, tick);
+    if (i != mu::nidx) {
+        return tick - (at(i)->utick - at(i)->tick);
     }
 
     ASSERT_X(String(u"tick %1 not found in RepeatList").arg(tick));
@@ -222,10 +286,12 @@ int RepeatList::tick2utick(int tick) const
     if (empty()) {
         return 0;
     }
-    for (const RepeatSegment* s : *this) {
-        if (tick >= s->tick && tick < (s->tick + s->len())) {
-            return s->utick + (tick - s->tick);
-        }
+    auto it = std::upper_bound(m_tickRanges.cbegin(), m_tickRanges.cend(), tick, [](int tick, const TickRange& range) {
+        return tick < range.tick;
+    });
+    if (it != m_tickRanges.cbegin() && tick < std::prev(it)->endTick) {
+        const RepeatSegment* s = at(std::prev(it)->segmentIdx);
+        return s->utick + (tick - s->tick);
     }
     return back()->utick + (tick - back()->tick);
 }
@@ -236,31 +302,66 @@ int RepeatList::tick2utick(int tick) const
 
 double RepeatList::utick2utime(int tick) const
 {
-    size_t n = size();
-    unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-    for (unsigned i = ii; i < n; ++i) {
-        if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i + 1)->utick))) {
-            int t     = tick - (at(i)->utick - at(i)->tick);
-            double tt = _score->tempomap()->tick2time(t) + at(i)->timeOffset;
-            return tt;
-        }
+    size_t i = findSegmentIdx(m_uticks, tick);
+    if (i != mu::nidx) {
+        int t     = tick - (at(i)->utick - at(i)->tick);
+        double tt = _score->tempomap()->tick2time(t) + at(i)->timeOffset;
+        return tt;
     }
     return 0.0;
 }
 
+//---------------------------------------------------------
+//   uticks2utimes
+///   Same as utick2utime for every utick, the sorted runs of uticks
+///   within a segment are converted in one batch
+//---------------------------------------------------------
+
+std::vector<double> RepeatList::uticks2utimes(const std::vector<int>& uticks) const
+{
+    std::vector<double> utimes;
+    utimes.reserve(uticks.size());
+
+    const TempoMap* tempomap = _score->tempomap();
+    std::vector<int> ticks;
+
+    size_t n = 0;
+    while (n < uticks.size()) {
+        size_t i = findSegmentIdx(m_uticks, uticks[n]);
+        if (i == mu::nidx) {
+            utimes.push_back(0.0);
+            ++n;
+            continue;
+        }
+
+        const RepeatSegment* s = at(i);
+        const int segmentEnd = i + 1 < size() ? at(i + 1)->utick : std::numeric_limits<int>::max();
+
+        ticks.clear();
+        for (; n < uticks.size() && uticks[n] >= s->utick && uticks[n] < segmentEnd; ++n) {
+            if (!ticks.empty() && uticks[n] < uticks[n - 1]) {
+                break;
+            }
+            ticks.push_back(uticks[n] - (s->utick - s->tick));
+        }
+
+        for (double time : tempomap->ticks2times(ticks)) {
+            utimes.push_back(time + s->timeOffset);
+        }
+    }
+
+    return utimes;
+}
+
 //---------------------------------------------------------
 //   utime2utick
 //---------------------------------------------------------
 
 int RepeatList::utime2utick(double secs) const
 {
-    size_t repeatSegmentsCount = size();
-    unsigned ii = (idx2 < repeatSegmentsCount) && (secs >= at(idx2)->utime) ? idx2 : 0;
-    for (unsigned i = ii; i < repeatSegmentsCount; ++i) {
-        if ((secs >= at(i)->utime) && ((i + 1 == repeatSegmentsCount) || (secs < at(i + 1)->utime))) {
-            idx2 = i;
-            return _score->tempomap()->time2tick(secs - at(i)->timeOffset) + (at(i)->utick - at(i)->tick);
-        }
+    size_t i = findSegmentIdx(m_utimes, secs);
+    if (i != mu::nidx) {
+        return _score->tempomap()->time2tick(secs - at(i)->timeOffset) + (at(i)->utick - at(i)->tick);
     }
 
     if (!empty()) {
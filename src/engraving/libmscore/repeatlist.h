@@ -79,8 +79,19 @@ class RepeatList : public std::vector<RepeatSegment*>
 {
     OBJECT_ALLOCATOR(engraving, RepeatList)
 
+    struct TickRange {
+        int tick = 0;
+        int endTick = 0;
+        size_t segmentIdx = 0;
+    };
+
     Score* _score = nullptr;
-    mutable unsigned idx1, idx2;     // cached values
+
+    //! NOTE Lookup tables are rebuilt whenever the segments or their start times change,
+    //! lookups don't modify the list, so they are safe to make from several threads at once
+    std::vector<int> m_uticks;              // start utick of every segment
+    std::vector<double> m_utimes;           // start utime of every segment
+    std::vector<TickRange> m_tickRanges;    // the first segment playing each tick, sorted by tick
 
     bool _expanded = false;
     bool _scoreChanged = true;
@@ -98,6 +109,7 @@ class RepeatList : public std::vector<RepeatSegment*>
                      Volta const** const activeVolta, RepeatListElement const** const startRepeatReference) const;
     void unwind();
     void flatten();
+    void updateLookupTables();
 
 public:
     RepeatList(Score* s);
@@ -113,6 +125,7 @@ public:
     int tick2utick(int tick) const;
     int utime2utick(double secs) const;
     double utick2utime(int) const;
+    std::vector<double> uticks2utimes(const std::vector<int>& uticks) const;
     void updateTempo();
     int ticks() const;
 
@@ -5740,6 +5740,14 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     m_engravingFont = engravingFonts()->fontByName(style().value(Sid::MusicalSymbolFont).value<String>().toStdString());
     _noteHeadWidth = m_engravingFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
 
+    if (isMaster()) {
+        //! NOTE Layout restarts one measure before st, so page 1 is also affected when st starts page 2
+        const Page* firstPage = pages().empty() ? nullptr : pages().front();
+        if (!firstPage || layoutMode() != LayoutMode::PAGE || firstPage->endTick() < Fraction(0, 1) || st <= firstPage->endTick()) {
+            masterScore()->invalidateThumbnail();
+        }
+    }
+
     m_layoutOptions.updateFromStyle(style());
     m_layout.doLayoutRange(m_layoutOptions, st, et);
 
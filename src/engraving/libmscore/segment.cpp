@@ -95,6 +95,68 @@ const char* Segment::subTypeName(SegmentType t)
     }
 }
 
+//---------------------------------------------------------
+//   storeElement
+//    the only place single _elist slots are written,
+//    keeps _occupiedTracks in sync
+//---------------------------------------------------------
+
+void Segment::storeElement(track_idx_t track, EngravingItem* el)
+{
+    _elist[track] = el;
+
+    uint64_t bit = uint64_t(1) << (track % 64);
+    if (el) {
+        _occupiedTracks[track / 64] |= bit;
+    } else {
+        _occupiedTracks[track / 64] &= ~bit;
+    }
+}
+
+//---------------------------------------------------------
+//   updateOccupiedTracks
+//    rebuild the occupancy bits after bulk changes of _elist
+//---------------------------------------------------------
+
+void Segment::updateOccupiedTracks()
+{
+    _occupiedTracks.assign((_elist.size() + 63) / 64, 0);
+    for (track_idx_t track = 0; track < _elist.size(); ++track) {
+        if (_elist[track]) {
+            _occupiedTracks[track / 64] |= uint64_t(1) << (track % 64);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   nextOccupiedTrack
+//    first track >= track holding an element, _elist.size() if none
+//---------------------------------------------------------
+
+track_idx_t Segment::nextOccupiedTrack(track_idx_t track) const
+{
+    const track_idx_t tracks = _elist.size();
+    if (track >= tracks) {
+        return tracks;
+    }
+
+    size_t word = track / 64;
+    uint64_t bits = _occupiedTracks[word] & (~uint64_t(0) << (track % 64));
+    while (!bits) {
+        if (++word == _occupiedTracks.size()) {
+            return tracks;
+        }
+        bits = _occupiedTracks[word];
+    }
+
+    track_idx_t next = word * 64;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++next;
+    }
+    return next;
+}
+
 //---------------------------------------------------------
 //   setElement
 //---------------------------------------------------------
@@ -103,10 +165,10 @@ void Segment::setElement(track_idx_t track, EngravingItem* el)
 {
     if (el) {
         el->setParent(this);
-        _elist[track] = el;
+        storeElement(track, el);
         setEmpty(false);
     } else {
-        _elist[track] = 0;
+        storeElement(track, 0);
         checkEmpty();
     }
 }
@@ -177,6 +239,7 @@ Segment::Segment(const Segment& s)
         }
         _elist.push_back(ne);
     }
+    updateOccupiedTracks();
     _shapes  = s._shapes;
 }
 
@@ -248,7 +311,8 @@ void Segment::init()
     size_t staves = score()->nstaves();
     size_t tracks = staves * VOICES;
     _elist.assign(tracks, 0);
-    _preAppendedItems.assign(tracks, 0);
+    _occupiedTracks.assign((tracks + 63) / 64, 0);
+    _preAppendedItems.clear();
     _shapes.assign(staves, Shape());
 }
 
@@ -501,10 +565,11 @@ EngravingItem* Segment::element(track_idx_t track) const
 void Segment::insertStaff(staff_idx_t staff)
 {
     track_idx_t track = staff * VOICES;
-    for (voice_idx_t voice = 0; voice < VOICES; ++voice) {
-        _elist.insert(_elist.begin() + track, 0);
-        _preAppendedItems.insert(_preAppendedItems.begin() + track, 0);
+    _elist.insert(_elist.begin() + track, VOICES, nullptr);
+    if (!_preAppendedItems.empty()) {
+        _preAppendedItems.insert(_preAppendedItems.begin() + track, VOICES, nullptr);
     }
+    updateOccupiedTracks();
     _shapes.insert(_shapes.begin() + staff, Shape());
 
     for (EngravingItem* e : _annotations) {
@@ -523,7 +588,10 @@ void Segment::removeStaff(staff_idx_t staff)
 {
     track_idx_t track = staff * VOICES;
     _elist.erase(_elist.begin() + track, _elist.begin() + track + VOICES);
-    _preAppendedItems.erase(_preAppendedItems.begin() + track, _preAppendedItems.begin() + track + VOICES);
+    if (!_preAppendedItems.empty()) {
+        _preAppendedItems.erase(_preAppendedItems.begin() + track, _preAppendedItems.begin() + track + VOICES);
+    }
+    updateOccupiedTracks();
     _shapes.erase(_shapes.begin() + staff);
 
     for (EngravingItem* e : _annotations) {
@@ -577,7 +645,7 @@ void Segment::add(EngravingItem* el)
 
     switch (el->type()) {
     case ElementType::MEASURE_REPEAT:
-        _elist[track] = el;
+        storeElement(track, el);
         setEmpty(false);
         break;
 
@@ -622,7 +690,7 @@ void Segment::add(EngravingItem* el)
     case ElementType::CLEF:
         assert(_segmentType == SegmentType::Clef || _segmentType == SegmentType::HeaderClef);
         checkElement(el, track);
-        _elist[track] = el;
+        storeElement(track, el);
         if (!el->generated()) {
             el->staff()->setClef(toClef(el));
         }
@@ -632,7 +700,7 @@ void Segment::add(EngravingItem* el)
     case ElementType::TIMESIG:
         assert(segmentType() == SegmentType::TimeSig || segmentType() == SegmentType::TimeSigAnnounce);
         checkElement(el, track);
-        _elist[track] = el;
+        storeElement(track, el);
         el->staff()->addTimeSig(toTimeSig(el));
         setEmpty(false);
         break;
@@ -640,7 +708,7 @@ void Segment::add(EngravingItem* el)
     case ElementType::KEYSIG:
         assert(_segmentType == SegmentType::KeySig || _segmentType == SegmentType::KeySigAnnounce);
         checkElement(el, track);
-        _elist[track] = el;
+        storeElement(track, el);
         if (!el->generated()) {
             el->staff()->setKey(tick(), toKeySig(el)->keySigEvent());
         }
@@ -685,7 +753,7 @@ void Segment::add(EngravingItem* el)
     case ElementType::BREATH:
         if (track < score()->nstaves() * VOICES) {
             checkElement(el, track);
-            _elist[track] = el;
+            storeElement(track, el);
         }
         setEmpty(false);
         break;
@@ -693,7 +761,7 @@ void Segment::add(EngravingItem* el)
     case ElementType::AMBITUS:
         assert(_segmentType == SegmentType::Ambitus);
         checkElement(el, track);
-        _elist[track] = el;
+        storeElement(track, el);
         setEmpty(false);
         break;
 
@@ -719,7 +787,7 @@ void Segment::remove(EngravingItem* el)
     case ElementType::CHORD:
     case ElementType::REST:
     {
-        _elist[track] = 0;
+        storeElement(track, 0);
         staff_idx_t staffIdx = el->staffIdx();
         measure()->checkMultiVoices(staffIdx);
         // spanners with this cr as start or end element will need relayout
@@ -745,7 +813,7 @@ void Segment::remove(EngravingItem* el)
 
     case ElementType::MMREST:
     case ElementType::MEASURE_REPEAT:
-        _elist[track] = 0;
+        storeElement(track, 0);
         break;
 
     case ElementType::DYNAMIC:
@@ -787,12 +855,12 @@ void Segment::remove(EngravingItem* el)
         break;
 
     case ElementType::TIMESIG:
-        _elist[track] = 0;
+        storeElement(track, 0);
         el->staff()->removeTimeSig(toTimeSig(el));
         break;
 
     case ElementType::KEYSIG:
-        _elist[track] = 0;
+        storeElement(track, 0);
         if (!el->generated()) {
             el->staff()->removeKey(tick());
         }
@@ -805,11 +873,11 @@ void Segment::remove(EngravingItem* el)
 
     case ElementType::BAR_LINE:
     case ElementType::AMBITUS:
-        _elist[track] = 0;
+        storeElement(track, 0);
         break;
 
     case ElementType::BREATH:
-        _elist[track] = 0;
+        storeElement(track, 0);
         score()->setPause(tick(), 0);
         break;
 
@@ -870,6 +938,7 @@ void Segment::sortStaves(std::vector<staff_idx_t>& dst)
         }
     }
     std::swap(_elist, dl);
+    updateOccupiedTracks();
     std::map<staff_idx_t, staff_idx_t> map;
     for (staff_idx_t k = 0; k < dst.size(); ++k) {
         map.insert({ dst[k], k });
@@ -902,12 +971,8 @@ void Segment::sortStaves(std::vector<staff_idx_t>& dst)
 
 void Segment::fixStaffIdx()
 {
-    int track = 0;
-    for (EngravingItem* e : _elist) {
-        if (e) {
-            e->setTrack(track);
-        }
-        ++track;
+    for (auto it = elements().begin(); it != elements().end(); ++it) {
+        (*it)->setTrack(it.track());
     }
 }
 
@@ -922,8 +987,8 @@ void Segment::checkEmpty() const
         return;
     }
     setEmpty(true);
-    for (const EngravingItem* e : _elist) {
-        if (e) {
+    for (uint64_t bits : _occupiedTracks) {
+        if (bits) {
             setEmpty(false);
             break;
         }
@@ -936,12 +1001,15 @@ void Segment::checkEmpty() const
 
 void Segment::swapElements(track_idx_t i1, track_idx_t i2)
 {
-    std::iter_swap(_elist.begin() + i1, _elist.begin() + i2);
-    if (_elist[i1]) {
-        _elist[i1]->setTrack(i1);
+    EngravingItem* e1 = _elist[i1];
+    EngravingItem* e2 = _elist[i2];
+    storeElement(i1, e2);
+    storeElement(i2, e1);
+    if (e2) {
+        e2->setTrack(i1);
     }
-    if (_elist[i2]) {
-        _elist[i2]->setTrack(i2);
+    if (e1) {
+        e1->setTrack(i2);
     }
     triggerLayout();
 }
@@ -2345,8 +2413,27 @@ void Segment::createShape(staff_idx_t staffIdx)
     addPreAppendedToShape(static_cast<int>(staffIdx), s);
 }
 
+void Segment::preAppend(EngravingItem* item, int track)
+{
+    if (_preAppendedItems.empty()) {
+        _preAppendedItems.assign(_elist.size(), nullptr);
+    }
+    _preAppendedItems[track] = item;
+}
+
+void Segment::clearPreAppended(int track)
+{
+    if (track < int(_preAppendedItems.size())) {
+        _preAppendedItems[track] = nullptr;
+    }
+}
+
 void Segment::addPreAppendedToShape(int staffIdx, Shape& s)
 {
+    if (_preAppendedItems.empty()) {
+        return;
+    }
+
     for (unsigned track = staffIdx * VOICES; track < staffIdx * VOICES + VOICES; ++track) {
         if (!_preAppendedItems[track]) {
             continue;
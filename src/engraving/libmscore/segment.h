@@ -94,8 +94,12 @@ class Segment final : public EngravingItem
     Segment* _prev = nullptr;
 
     std::vector<EngravingItem*> _annotations;
+    //! NOTE _elist stays dense, so element(track) is O(1) and elist() keeps its meaning;
+    //! _occupiedTracks only speeds up iteration, at 8 bytes per 16 staves
     std::vector<EngravingItem*> _elist;         // EngravingItem storage, size = staves * VOICES.
-    std::vector<EngravingItem*> _preAppendedItems; // Container for items appended to the left of this segment (example: grace notes), size = staves * VOICES.
+    std::vector<uint64_t> _occupiedTracks;      // one bit per _elist slot, set if the slot holds an element
+    std::vector<EngravingItem*> _preAppendedItems; // Container for items appended to the left of this segment (example: grace notes),
+                                                   // size = staves * VOICES once anything is pre-appended, empty before
     std::vector<Shape> _shapes;           // size = staves
     double m_spacing{ 0 };
 
@@ -108,6 +112,10 @@ class Segment final : public EngravingItem
 
     void init();
     void checkEmpty() const;
+
+    void storeElement(track_idx_t track, EngravingItem* el);
+    void updateOccupiedTracks();
+    track_idx_t nextOccupiedTrack(track_idx_t track) const;
     void checkElement(EngravingItem*, track_idx_t track);
     void setEmpty(bool val) const { setFlag(ElementFlag::EMPTY, val); }
 
@@ -166,8 +174,35 @@ public:
     //@ returns the element at track 'track' (null if none)
     EngravingItem* elementAt(track_idx_t track) const;
 
+    //! NOTE: one slot per track, most of them null in scores with many staves;
+    //! prefer elements() for iterating
     const std::vector<EngravingItem*>& elist() const { return _elist; }
-    std::vector<EngravingItem*>& elist() { return _elist; }
+
+    //! iterates the non-empty tracks only, in track order
+    class ElementIterator
+    {
+    public:
+        ElementIterator(const Segment* segment, track_idx_t track)
+            : m_segment(segment), m_track(track) {}
+
+        EngravingItem* operator*() const { return m_segment->_elist[m_track]; }
+        ElementIterator& operator++() { m_track = m_segment->nextOccupiedTrack(m_track + 1); return *this; }
+        bool operator!=(const ElementIterator& other) const { return m_track != other.m_track; }
+        track_idx_t track() const { return m_track; }
+
+    private:
+        const Segment* m_segment = nullptr;
+        track_idx_t m_track = 0;
+    };
+
+    struct ElementRange
+    {
+        const Segment* segment = nullptr;
+        ElementIterator begin() const { return ElementIterator(segment, segment->nextOccupiedTrack(0)); }
+        ElementIterator end() const { return ElementIterator(segment, segment->_elist.size()); }
+    };
+
+    ElementRange elements() const { return ElementRange { this }; }
 
     void removeElement(track_idx_t track);
     void setElement(track_idx_t track, EngravingItem* el);
@@ -323,9 +358,10 @@ public:
 
     bool hasAccidentals() const;
 
-    EngravingItem* preAppendedItem(int track) { return _preAppendedItems[track]; }
-    void preAppend(EngravingItem* item, int track) { _preAppendedItems[track] = item; }
-    void clearPreAppended(int track) { _preAppendedItems[track] = nullptr; }
+    bool hasPreAppendedItems() const { return !_preAppendedItems.empty(); }
+    EngravingItem* preAppendedItem(int track) { return track < int(_preAppendedItems.size()) ? _preAppendedItems[track] : nullptr; }
+    void preAppend(EngravingItem* item, int track);
+    void clearPreAppended(int track);
     void addPreAppendedToShape(int staffIdx, Shape& s);
 
     static constexpr SegmentType durationSegmentsMask = SegmentType::ChordRest;   // segment types which may have non-zero tick length
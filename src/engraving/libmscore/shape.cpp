@@ -97,15 +97,70 @@ Shape Shape::translated(const PointF& pt) const
 //    so they don’t touch.
 //-------------------------------------------------------------------
 
+//! NOTE Same as EngravingItem::computeKerningType, using the prepared info
+//! unless one of the items has its own kerning rules
+static KerningType computeKerningType(const EngravingItem* item1, const HorizontalSpacingInfo& info1,
+                                      const EngravingItem* item2, const HorizontalSpacingInfo& info2)
+{
+    if (info1.customKerning) {
+        return item1->computeKerningType(item2);
+    }
+    if (info1.userSetKerning != KerningType::NOT_SET) {
+        return info1.userSetKerning;
+    }
+    if (info1.sameVoiceKerningLimited && info2.sameVoiceKerningLimited && info1.track == info2.track) {
+        return KerningType::NON_KERNING;
+    }
+    if ((info1.neverKernable || info2.neverKernable)
+        && !(info1.alwaysKernable || info2.alwaysKernable)) {
+        return KerningType::NON_KERNING;
+    }
+    return KerningType::KERNING;
+}
+
+//! NOTE Same as EngravingItem::computePadding, using the prepared info
+//! unless the first item has its own padding rules
+static double computePadding(const EngravingItem* item1, const HorizontalSpacingInfo& info1,
+                             const EngravingItem* item2, const HorizontalSpacingInfo& info2)
+{
+    if (info1.customPadding) {
+        return item1->computePadding(item2);
+    }
+    double scaling = (info1.mag + info2.mag) / 2;
+    return info1.score->paddingTable().at(info1.type).at(info2.type) * scaling;
+}
+
+static void collectHorizontalSpacingInfo(const Shape& shape, std::vector<HorizontalSpacingInfo>& infos)
+{
+    infos.clear();
+    infos.reserve(shape.size());
+    for (const ShapeElement& r : shape) {
+        infos.push_back(r.toItem ? r.toItem->horizontalSpacingInfo() : HorizontalSpacingInfo());
+    }
+}
+
 double Shape::minHorizontalDistance(const Shape& a, Score* score) const
 {
     double dist = -1000000.0;        // min real
     double verticalClearance = 0.2 * score->spatium();
-    for (const ShapeElement& r2 : a) {
+
+    //! NOTE Item properties are gathered once per shape element rather than
+    //! queried through virtual calls for each of the (this x a) pairs
+    thread_local std::vector<HorizontalSpacingInfo> infos1;
+    thread_local std::vector<HorizontalSpacingInfo> infos2;
+    collectHorizontalSpacingInfo(*this, infos1);
+    collectHorizontalSpacingInfo(a, infos2);
+
+    for (size_t j = 0; j < a.size(); ++j) {
+        const ShapeElement& r2 = a[j];
         const EngravingItem* item2 = r2.toItem;
+        const HorizontalSpacingInfo& info2 = infos2[j];
         double by1 = r2.top();
         double by2 = r2.bottom();
-        for (const ShapeElement& r1 : *this) {
+        bool r2ZeroWidth = r2.width() == 0;
+        bool r2Lyrics = item2 && item2->isLyrics();
+        for (size_t i = 0; i < size(); ++i) {
+            const ShapeElement& r1 = at(i);
             const EngravingItem* item1 = r1.toItem;
             double ay1 = r1.top();
             double ay2 = r1.bottom();
@@ -113,12 +168,12 @@ double Shape::minHorizontalDistance(const Shape& a, Score* score) const
             double padding = 0;
             KerningType kerningType = KerningType::NON_KERNING;
             if (item1 && item2) {
-                padding = item1->computePadding(item2);
-                kerningType = item1->computeKerningType(item2);
+                padding = computePadding(item1, infos1[i], item2, info2);
+                kerningType = computeKerningType(item1, infos1[i], item2, info2);
             }
             if ((intersection && kerningType != KerningType::ALLOW_COLLISION)
-                || (r1.width() == 0 || r2.width() == 0) // Temporary hack: shapes of zero-width are assumed to collide with everyghin
-                || (!item1 && item2 && item2->isLyrics()) // Temporary hack: avoids collision with melisma line
+                || (r1.width() == 0 || r2ZeroWidth) // Temporary hack: shapes of zero-width are assumed to collide with everyghin
+                || (!item1 && r2Lyrics) // Temporary hack: avoids collision with melisma line
                 || kerningType == KerningType::NON_KERNING) {
                 dist = std::max(dist, r1.right() - r2.left() + padding);
             }
@@ -43,6 +43,7 @@ class StemSlash final : public EngravingItem
     StemSlash(Chord* parent = 0);
     double _width;
     KerningType doComputeKerningType(const EngravingItem* nextItem) const override;
+    bool hasCustomKerning() const override { return true; }
 
 public:
 
@@ -22,6 +22,7 @@
 
 #include "tempo.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "rw/xml.h"
@@ -130,9 +131,37 @@ void TempoMap::normalize()
         tick  = e->first;
         tempo = e->second.tempo.val;
     }
+    updateFlatEvents();
     ++_tempoSN;
 }
 
+//---------------------------------------------------------
+//   updateFlatEvents
+//---------------------------------------------------------
+
+void TempoMap::updateFlatEvents()
+{
+    m_flatEvents.clear();
+    m_flatEvents.reserve(size());
+    for (const auto& e : *this) {
+        m_flatEvents.push_back({ e.first, e.second.tempo, e.second.pause, e.second.time });
+    }
+}
+
+//---------------------------------------------------------
+//   flatEventAt
+///   The last event at or before the given tick,
+///   or the end if there is none
+//---------------------------------------------------------
+
+std::vector<TempoMap::FlatEvent>::const_iterator TempoMap::flatEventAt(int tick) const
+{
+    auto e = std::upper_bound(m_flatEvents.cbegin(), m_flatEvents.cend(), tick, [](int tick, const FlatEvent& e) {
+        return tick < e.tick;
+    });
+    return e == m_flatEvents.cbegin() ? m_flatEvents.cend() : std::prev(e);
+}
+
 //---------------------------------------------------------
 //   TempoMap::dump
 //---------------------------------------------------------
@@ -153,6 +182,7 @@ void TempoMap::dump() const
 void TempoMap::clear()
 {
     std::map<int, TEvent>::clear();
+    m_flatEvents.clear();
     ++_tempoSN;
 }
 
@@ -170,6 +200,7 @@ void TempoMap::clearRange(int tick1, int tick2)
         return;
     }
     erase(first, last);
+    updateFlatEvents();
     ++_tempoSN;
 }
 
@@ -179,30 +210,10 @@ void TempoMap::clearRange(int tick1, int tick2)
 
 BeatsPerSecond TempoMap::tempo(int tick) const
 {
-    auto findTempo = [this](int tick) -> BeatsPerSecond {
-        if (empty()) {
-            return 2.0;
-        }
-
-        auto i = lower_bound(tick);
-        if (i == end()) {
-            --i;
-            return i->second.tempo;
-        }
-
-        if (i->first == tick) {
-            return i->second.tempo;
-        }
-
-        if (i == begin()) {
-            return 2.0;
-        }
+    auto e = flatEventAt(tick);
+    BeatsPerSecond tempo = e == m_flatEvents.cend() ? BeatsPerSecond(2.0) : e->tempo;
 
-        --i;
-        return i->second.tempo;
-    };
-
-    return findTempo(tick) * _tempoMultiplier;
+    return tempo * _tempoMultiplier;
 }
 
 //---------------------------------------------------------
@@ -286,25 +297,13 @@ double TempoMap::tick2time(int tick, int* sn) const
     double delta = double(tick);
     BeatsPerSecond tempo = 2.0;
 
-    if (!empty()) {
+    if (!m_flatEvents.empty()) {
         int ptick  = 0;
-        auto e = lower_bound(tick);
-        if (e == end()) {
-            auto pe = e;
-            --pe;
-            ptick = pe->first;
-            tempo = pe->second.tempo;
-            time  = pe->second.time;
-        } else if (e->first == tick) {
-            ptick = tick;
-            tempo = e->second.tempo;
-            time  = e->second.time;
-        } else if (e != begin()) {
-            auto pe = e;
-            --pe;
-            ptick = pe->first;
-            tempo = pe->second.tempo;
-            time  = pe->second.time;
+        auto e = flatEventAt(tick);
+        if (e != m_flatEvents.cend()) {
+            ptick = e->tick;
+            tempo = e->tempo;
+            time  = e->time;
         }
         delta = double(tick - ptick);
     } else {
@@ -329,18 +328,20 @@ int TempoMap::time2tick(double time, int* sn) const
 
     delta = 0.0;
     tempo = 2.0;
-    for (auto e = begin(); e != end(); ++e) {
-        // if in a pause period, wait on previous tick
-        if ((time <= e->second.time) && (time > e->second.time - e->second.pause)) {
-            delta = (time - (e->second.time - e->second.pause) + delta);
-            break;
-        }
-        if (e->second.time >= time) {
-            break;
-        }
-        delta = e->second.time;
-        tick  = e->first;
-        tempo = e->second.tempo;
+
+    // the first event at or after the given time, the times are ascending
+    auto e = std::lower_bound(m_flatEvents.cbegin(), m_flatEvents.cend(), time, [](const FlatEvent& e, double time) {
+        return e.time < time;
+    });
+    if (e != m_flatEvents.cbegin()) {
+        auto pe = std::prev(e);
+        delta = pe->time;
+        tick  = pe->tick;
+        tempo = pe->tempo;
+    }
+    // if in a pause period, wait on previous tick
+    if (e != m_flatEvents.cend() && time > e->time - e->pause) {
+        delta = (time - (e->time - e->pause) + delta);
     }
     delta = time - delta;
     tick += lrint(delta * _tempoMultiplier.val * Constants::division * tempo.val);
@@ -349,4 +350,35 @@ int TempoMap::time2tick(double time, int* sn) const
     }
     return tick;
 }
+
+//---------------------------------------------------------
+//   ticks2times
+///   Same as tick2time for every tick, but the ticks must be
+///   sorted, then they are merged with the events in one pass
+//---------------------------------------------------------
+
+std::vector<double> TempoMap::ticks2times(const std::vector<int>& sortedTicks) const
+{
+    assert(std::is_sorted(sortedTicks.cbegin(), sortedTicks.cend()));
+
+    std::vector<double> times;
+    times.reserve(sortedTicks.size());
+
+    auto next = m_flatEvents.cbegin();
+    int ptick = 0;
+    double ptime = 0.0;
+    BeatsPerSecond tempo = 2.0;
+
+    for (int tick : sortedTicks) {
+        while (next != m_flatEvents.cend() && next->tick <= tick) {
+            ptick = next->tick;
+            ptime = next->time;
+            tempo = next->tempo;
+            ++next;
+        }
+        times.push_back(ptime + double(tick - ptick) / (Constants::division * tempo.val * _tempoMultiplier.val));
+    }
+
+    return times;
+}
 }
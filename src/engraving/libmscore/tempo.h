@@ -24,6 +24,7 @@
 #define __AL_TEMPO_H__
 
 #include <map>
+#include <vector>
 
 #include "global/allocator.h"
 #include "global/async/notification.h"
@@ -72,12 +73,25 @@ class TempoMap : public std::map<int, TEvent>
 {
     OBJECT_ALLOCATOR(engraving, TempoMap)
 
+    struct FlatEvent {
+        int tick = 0;
+        BeatsPerSecond tempo;
+        double pause = 0.0;
+        double time = 0.0;
+    };
+
     int _tempoSN = 0; // serial no to track tempo changes
     BeatsPerSecond _tempo; // tempo if not using tempo list (beats per second)
     BeatsPerSecond _tempoMultiplier;
 
+    //! NOTE A copy of the events in a sorted array, lookups binary search it instead of walking the tree.
+    //! Gradual tempo changes are in it too, Score::setUpTempoMap adds their steps as regular events
+    std::vector<FlatEvent> m_flatEvents;
+
     void normalize();
     void del(int tick);
+    void updateFlatEvents();
+    std::vector<FlatEvent>::const_iterator flatEventAt(int tick) const;
 
 public:
     TempoMap();
@@ -93,6 +107,7 @@ public:
     double tick2time(int tick, double time, int* sn) const;
     int time2tick(double time, int* sn = 0) const;
     int time2tick(double time, int tick, int* sn) const;
+    std::vector<double> ticks2times(const std::vector<int>& sortedTicks) const;
     int tempoSN() const { return _tempoSN; }
 
     void setTempo(int t, BeatsPerSecond);
@@ -23,6 +23,8 @@
 #include <cmath>
 #include <stack>
 
+#include "hashutils.h"
+
 #include "draw/fontmetrics.h"
 #include "draw/types/pen.h"
 #include "draw/types/brush.h"
@@ -39,6 +41,7 @@
 #include "types/typesconv.h"
 
 #include "box.h"
+#include "masterscore.h"
 #include "measure.h"
 #include "mscore.h"
 #include "page.h"
@@ -121,6 +124,125 @@ bool CharFormat::operator==(const CharFormat& cf) const
            && cf.fontFamily() == fontFamily();
 }
 
+//---------------------------------------------------------
+//   TextShapingCache
+//---------------------------------------------------------
+
+static constexpr size_t SHAPING_CACHE_CAPACITY = 20000;
+
+static void hashFormat(size_t& seed, const CharFormat& format)
+{
+    hashCombine(seed, format.fontFamily());
+    hashCombine(seed, format.fontSize());
+    hashCombine(seed, static_cast<int>(format.style()));
+    hashCombine(seed, static_cast<int>(format.valign()));
+}
+
+size_t TextShapingCache::ParseKeyHash::operator()(const ParseKey& k) const
+{
+    size_t seed = std::hash<String> {}(k.text);
+    hashFormat(seed, k.format);
+    return seed;
+}
+
+size_t TextShapingCache::ShapeKeyHash::operator()(const ShapeKey& k) const
+{
+    size_t seed = std::hash<double> {}(k.sizeScale);
+    hashCombine(seed, k.mag);
+    hashCombine(seed, k.symbolTextType);
+    hashCombine(seed, k.musicalSymbolFont);
+    hashCombine(seed, k.musicalTextFont);
+    for (const auto& fragment : k.fragments) {
+        hashCombine(seed, fragment.first);
+        hashFormat(seed, fragment.second);
+    }
+    return seed;
+}
+
+bool TextShapingCache::ShapeKey::operator==(const ShapeKey& k) const
+{
+    return sizeScale == k.sizeScale
+           && mag == k.mag
+           && symbolTextType == k.symbolTextType
+           && musicalSymbolFont == k.musicalSymbolFont
+           && musicalTextFont == k.musicalTextFont
+           && fragments == k.fragments;
+}
+
+template<typename Key, typename Value, typename Hash>
+bool TextShapingCache::Lru<Key, Value, Hash>::find(const Key& key, Value& value)
+{
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        return false;
+    }
+    m_list.splice(m_list.begin(), m_list, it->second);
+    value = it->second->second;
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash>
+void TextShapingCache::Lru<Key, Value, Hash>::insert(const Key& key, const Value& value)
+{
+    if (m_index.find(key) != m_index.end()) {
+        return;
+    }
+    if (m_list.size() >= SHAPING_CACHE_CAPACITY) {
+        m_index.erase(m_list.back().first);
+        m_list.pop_back();
+    }
+    m_list.emplace_front(key, value);
+    m_index.emplace(m_list.front().first, m_list.begin());
+}
+
+template<typename Key, typename Value, typename Hash>
+void TextShapingCache::Lru<Key, Value, Hash>::clear()
+{
+    m_index.clear();
+    m_list.clear();
+}
+
+TextShapingCache::TextShapingCache()
+{
+    //! NOTE Shapes are measured with the fonts, registering a font may change them
+    if (fontProvider()) {
+        fontProvider()->fontsChanged().onNotify(this, [this]() {
+            clear();
+        });
+    }
+}
+
+bool TextShapingCache::findParsed(const ParseKey& key, ParsedText& parsed) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_parsed.find(key, parsed);
+}
+
+void TextShapingCache::insertParsed(const ParseKey& key, const ParsedText& parsed)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_parsed.insert(key, parsed);
+}
+
+bool TextShapingCache::findShape(const ShapeKey& key, Shape& shape) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_shapes.find(key, shape);
+}
+
+void TextShapingCache::insertShape(const ShapeKey& key, const Shape& shape)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shapes.insert(key, shape);
+}
+
+void TextShapingCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_parsed.clear();
+    m_shapes.clear();
+}
+
 //---------------------------------------------------------
 //   clearSelection
 //---------------------------------------------------------
@@ -879,7 +1001,6 @@ void TextBlock::draw(mu::draw::Painter* p, const TextBase* t) const
 void TextBlock::layout(TextBase* t)
 {
     _bbox        = RectF();
-    double x      = 0.0;
     _lineSpacing = 0.0;
     double lm     = 0.0;
 
@@ -916,7 +1037,90 @@ void TextBlock::layout(TextBase* t)
         mu::draw::FontMetrics fm = t->fontMetrics();
         _bbox.setRect(0.0, -fm.ascent(), 1.0, fm.descent());
         _lineSpacing = fm.lineSpacing();
-    } else if (_fragments.size() == 1 && _fragments.front().text.isEmpty()) {
+    } else {
+        shape(t);
+    }
+
+    // Apply style/custom line spacing
+    _lineSpacing *= t->textLineSpacing();
+
+    double rx = 0;
+    switch (t->align().horizontal) {
+    case AlignH::LEFT:
+        rx = -_bbox.left();
+        break;
+    case AlignH::HCENTER:
+        rx = (layoutWidth - (_bbox.left() + _bbox.right())) * .5;
+        break;
+    case AlignH::RIGHT:
+        rx = layoutWidth - _bbox.right();
+        break;
+    }
+
+    rx += lm;
+    for (TextFragment& f : _fragments) {
+        f.pos.rx() += rx;
+    }
+    _bbox.translate(rx, 0.0);
+}
+
+//---------------------------------------------------------
+//   shapeKey
+//---------------------------------------------------------
+
+static TextShapingCache::ShapeKey shapeKey(const std::list<TextFragment>& fragments, const TextBase* t)
+{
+    TextShapingCache::ShapeKey key;
+    key.fragments.reserve(fragments.size());
+
+    bool hasScoreText = false;
+    for (const TextFragment& f : fragments) {
+        key.fragments.push_back({ f.text, f.format });
+        hasScoreText = hasScoreText || f.format.fontFamily() == "ScoreText";
+    }
+
+    key.sizeScale = t->sizeIsSpatiumDependent() ? t->spatium() / SPATIUM20 : 1.0;
+    key.mag = t->mag();
+
+    if (hasScoreText) {
+        if (t->isDynamic() || t->textStyleType() == TextStyleType::OTTAVA) {
+            key.symbolTextType = 1;
+        } else if (t->isTempoText()) {
+            key.symbolTextType = 2;
+        }
+        key.musicalSymbolFont = t->score()->styleSt(Sid::MusicalSymbolFont);
+        key.musicalTextFont = t->score()->styleSt(Sid::MusicalTextFont);
+    }
+
+    return key;
+}
+
+//---------------------------------------------------------
+//   shape
+//    position and measure the fragments, without alignment
+//---------------------------------------------------------
+
+void TextBlock::shape(const TextBase* t)
+{
+    TextShapingCache* cache = t->shapingCache();
+    TextShapingCache::ShapeKey key;
+    if (cache) {
+        key = shapeKey(_fragments, t);
+        TextShapingCache::Shape cached;
+        if (cache->findShape(key, cached)) {
+            auto pos = cached.fragmentPositions.cbegin();
+            for (TextFragment& f : _fragments) {
+                f.pos = *pos++;
+            }
+            _bbox = cached.bbox;
+            _lineSpacing = cached.lineSpacing;
+            return;
+        }
+    }
+
+    double x = 0.0;
+
+    if (_fragments.size() == 1 && _fragments.front().text.isEmpty()) {
         auto fi = _fragments.begin();
         TextFragment& f = *fi;
         f.pos.setX(x);
@@ -967,27 +1171,16 @@ void TextBlock::layout(TextBase* t)
         }
     }
 
-    // Apply style/custom line spacing
-    _lineSpacing *= t->textLineSpacing();
-
-    double rx = 0;
-    switch (t->align().horizontal) {
-    case AlignH::LEFT:
-        rx = -_bbox.left();
-        break;
-    case AlignH::HCENTER:
-        rx = (layoutWidth - (_bbox.left() + _bbox.right())) * .5;
-        break;
-    case AlignH::RIGHT:
-        rx = layoutWidth - _bbox.right();
-        break;
-    }
-
-    rx += lm;
-    for (TextFragment& f : _fragments) {
-        f.pos.rx() += rx;
+    if (cache) {
+        TextShapingCache::Shape shaped;
+        shaped.fragmentPositions.reserve(_fragments.size());
+        for (const TextFragment& f : _fragments) {
+            shaped.fragmentPositions.push_back(f.pos);
+        }
+        shaped.bbox = _bbox;
+        shaped.lineSpacing = _lineSpacing;
+        cache->insertShape(key, shaped);
     }
-    _bbox.translate(rx, 0.0);
 }
 
 //---------------------------------------------------------
@@ -1684,6 +1877,20 @@ void TextBase::createLayout()
     cursor.setRow(0);
     cursor.setColumn(0);
 
+    //! NOTE The layout only depends on the text and the format it starts with,
+    //! so identical texts of the score are parsed once
+    TextShapingCache* cache = shapingCache();
+    TextShapingCache::ParseKey parseKey { _text, *cursor.format() };
+    TextShapingCache::ParsedText parsed;
+    if (cache && cache->findParsed(parseKey, parsed)) {
+        _layout = std::move(parsed.blocks);
+        if (parsed.fontFaceUnstyled) {
+            setPropertyFlags(Pid::FONT_FACE, PropertyFlags::UNSTYLED);
+        }
+        layoutInvalid = false;
+        return;
+    }
+
     int state = 0;
     String token;
     String sym;
@@ -1737,7 +1944,10 @@ void TextBase::createLayout()
         } else if (state == 1) {
             if (c == '>') {
                 state = 0;
-                prepareFormat(token, cursor);
+                if (prepareFormat(token, *cursor.format())) {
+                    setPropertyFlags(Pid::FONT_FACE, PropertyFlags::UNSTYLED);
+                    parsed.fontFaceUnstyled = true;
+                }
                 if (token == "sym") {
                     symState = true;
                     sym.clear();
@@ -1781,6 +1991,10 @@ void TextBase::createLayout()
     if (_layout.empty()) {
         _layout.push_back(TextBlock());
     }
+    if (cache) {
+        parsed.blocks = _layout;
+        cache->insertParsed(parseKey, parsed);
+    }
     layoutInvalid = false;
 }
 
@@ -2806,6 +3020,18 @@ mu::draw::FontMetrics TextBase::fontMetrics() const
     return mu::draw::FontMetrics(font());
 }
 
+//---------------------------------------------------------
+//   shapingCache
+//---------------------------------------------------------
+
+TextShapingCache* TextBase::shapingCache() const
+{
+    if (!score() || !masterScore()) {
+        return nullptr;
+    }
+    return masterScore()->textShapingCache();
+}
+
 //---------------------------------------------------------
 //   getProperty
 //---------------------------------------------------------
@@ -23,11 +23,16 @@
 #ifndef __TEXTBASE_H__
 #define __TEXTBASE_H__
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include <variant>
 
 #include "modularity/ioc.h"
+#include "async/asyncable.h"
 
 #include "draw/fontmetrics.h"
+#include "draw/ifontprovider.h"
 #include "draw/types/color.h"
 #include "style/style.h"
 #include "iengravingfontsprovider.h"
@@ -241,6 +246,7 @@ class TextBlock
     bool _eol = false;
 
     void simplify();
+    void shape(const TextBase*);
 
 public:
     TextBlock() {}
@@ -274,6 +280,89 @@ public:
     void changeFormat(FormatId, const FormatValue& val, int start, int n);
 };
 
+//---------------------------------------------------------
+//   TextShapingCache
+//    parsed and measured text, shared by all text elements of a score
+//    and addressed by content: identical syllables, dynamics, measure
+//    numbers etc. are parsed and measured only once
+//---------------------------------------------------------
+
+class TextShapingCache : public async::Asyncable
+{
+    INJECT(engraving, draw::IFontProvider, fontProvider)
+
+public:
+    TextShapingCache();
+
+    struct ParseKey {
+        String text;
+        CharFormat format;                  // format at the start of the text
+
+        bool operator==(const ParseKey& k) const { return text == k.text && format == k.format; }
+    };
+
+    struct ParsedText {
+        std::vector<TextBlock> blocks;
+        bool fontFaceUnstyled = false;
+    };
+
+    // everything TextFragment::font() depends on
+    struct ShapeKey {
+        std::vector<std::pair<String, CharFormat> > fragments;
+        double sizeScale = 1.0;
+        double mag = 1.0;
+        int symbolTextType = 0;
+        String musicalSymbolFont;
+        String musicalTextFont;
+
+        bool operator==(const ShapeKey& k) const;
+    };
+
+    // positions are not aligned yet
+    struct Shape {
+        std::vector<mu::PointF> fragmentPositions;
+        mu::RectF bbox;
+        double lineSpacing = 0.0;
+    };
+
+    bool findParsed(const ParseKey& key, ParsedText& parsed) const;
+    void insertParsed(const ParseKey& key, const ParsedText& parsed);
+
+    bool findShape(const ShapeKey& key, Shape& shape) const;
+    void insertShape(const ShapeKey& key, const Shape& shape);
+
+    void clear();
+
+private:
+    struct ParseKeyHash {
+        size_t operator()(const ParseKey& k) const;
+    };
+
+    struct ShapeKeyHash {
+        size_t operator()(const ShapeKey& k) const;
+    };
+
+    // the least recently used entries are dropped when it gets full
+    template<typename Key, typename Value, typename Hash>
+    class Lru
+    {
+    public:
+        bool find(const Key& key, Value& value);
+        void insert(const Key& key, const Value& value);
+        void clear();
+
+    private:
+        using List = std::list<std::pair<Key, Value> >;
+
+        List m_list;
+        std::unordered_map<Key, typename List::iterator, Hash> m_index;
+    };
+
+    mutable std::mutex m_mutex;
+    mutable Lru<ParseKey, ParsedText, ParseKeyHash> m_parsed;
+    mutable Lru<ShapeKey, Shape, ShapeKeyHash> m_shapes;
+};
+
 //---------------------------------------------------------
 //   TextBase
 //---------------------------------------------------------
@@ -448,6 +537,7 @@ public:
 
     mu::draw::Font font() const;
     mu::draw::FontMetrics fontMetrics() const;
+    TextShapingCache* shapingCache() const;
 
     PropertyValue getProperty(Pid propertyId) const override;
     bool setProperty(Pid propertyId, const PropertyValue& v) override;
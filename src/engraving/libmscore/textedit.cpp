@@ -95,6 +95,8 @@ void TextBase::startEdit(EditData& ed)
 
     ted->oldXmlText = xmlText();
     ted->startUndoIdx = score()->undoStack()->getCurIdx();
+    // endEdit() merges the macros from here on, or from the one adding this text
+    score()->undoStack()->setMergeStartIdx(ted->startUndoIdx > 0 ? ted->startUndoIdx - 1 : 0);
 
     if (layoutInvalid) {
         layout();
@@ -126,6 +128,9 @@ void TextBase::endEdit(EditData& ed)
         return;
     }
 
+    //! NOTE Nothing is evicted before the merges below, as that only happens when a macro ends
+    undo->resetMergeStartIdx();
+
     const String actualXmlText = xmlText();
     const String actualPlainText = plainText();
 
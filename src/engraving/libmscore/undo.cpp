@@ -34,6 +34,8 @@
 
 #include "undo.h"
 
+#include <typeinfo>
+
 #include "iengravingfont.h"
 
 #include "bend.h"
@@ -168,6 +170,38 @@ void UndoCommand::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   UndoCommand::memoryUsage
+///   An estimate of the memory held by the command,
+///   when it is done or when it is undone
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryUsage(bool done) const
+{
+    size_t size = sizeof(UndoCommand);
+    for (const UndoCommand* c : childList) {
+        size += c->memoryUsage(done);
+    }
+    return size;
+}
+
+//! NOTE The exact size of the items isn't known here, this is an average one
+static constexpr size_t ITEM_MEMORY_USAGE_ESTIMATE = 256;
+
+static size_t itemTreeMemoryUsage(EngravingItem* item)
+{
+    if (!item) {
+        return 0;
+    }
+
+    size_t count = 0;
+    item->scanElements(&count, [](void* data, EngravingItem*) {
+        ++(*static_cast<size_t*>(data));
+    }, true);
+
+    return std::max<size_t>(count, 1) * ITEM_MEMORY_USAGE_ESTIMATE;
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -309,6 +343,51 @@ void UndoStack::setLocked(bool val)
     isLocked = val;
 }
 
+//---------------------------------------------------------
+//   setLimits
+//---------------------------------------------------------
+
+void UndoStack::setLimits(size_t maxSteps, size_t maxMemoryUsage)
+{
+    m_maxSteps = maxSteps;
+    m_maxMemoryUsage = maxMemoryUsage;
+    evictOldest();
+}
+
+//---------------------------------------------------------
+//   evictOldest
+///   Drops the oldest macros while the stack is over its limits,
+///   the last done macro is always kept
+//---------------------------------------------------------
+
+void UndoStack::evictOldest()
+{
+    auto overLimits = [this]() {
+        return (m_maxSteps && list.size() > m_maxSteps) || (m_maxMemoryUsage && m_memoryUsage > m_maxMemoryUsage);
+    };
+
+    //! NOTE Macros that are going to be merged, e.g. those of the text being edited, must stay
+    while (curIdx > 1 && m_evictedCount < m_mergeStartIdx && overLimits()) {
+        UndoMacro* cmd = mu::takeFirst(list);
+        stateList.erase(stateList.begin());
+        --curIdx;
+        ++m_evictedCount;
+
+        takeMemoryUsage(cmd, true);
+        cmd->cleanup(true);
+        delete cmd;
+    }
+}
+
+//---------------------------------------------------------
+//   takeMemoryUsage
+//---------------------------------------------------------
+
+void UndoStack::takeMemoryUsage(const UndoCommand* cmd, bool done)
+{
+    m_memoryUsage -= std::min(m_memoryUsage, cmd->memoryUsage(done));
+}
+
 //---------------------------------------------------------
 //   beginMacro
 //---------------------------------------------------------
@@ -326,6 +405,21 @@ void UndoStack::beginMacro(Score* score)
     curCmd = new UndoMacro(score);
 }
 
+//---------------------------------------------------------
+//   isSamePropertyChange
+//---------------------------------------------------------
+
+static bool isSamePropertyChange(const UndoCommand* c1, const UndoCommand* c2)
+{
+    if (!c1 || !c2 || typeid(*c1) != typeid(ChangeProperty) || typeid(*c2) != typeid(ChangeProperty)) {
+        return false;
+    }
+
+    const ChangeProperty* p1 = static_cast<const ChangeProperty*>(c1);
+    const ChangeProperty* p2 = static_cast<const ChangeProperty*>(c2);
+    return p1->getElement() == p2->getElement() && p1->getId() == p2->getId();
+}
+
 //---------------------------------------------------------
 //   push
 //---------------------------------------------------------
@@ -350,8 +444,18 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
         LOG_UNDO() << cmd->name();
     }
 #endif
+    const std::list<UndoCommand*>& commands = curCmd->commands();
+    UndoCommand* prev = commands.empty() ? nullptr : commands.back();
+
     curCmd->appendChild(cmd);
     cmd->redo(ed);
+
+    //! NOTE Consecutive changes of the same property are kept as one change from the first old value,
+    //! undoing it restores the same state, and long drags or slider edits don't grow the macro
+    if (isSamePropertyChange(prev, cmd) && commands.size() > 1
+        && commands.back() == cmd && *std::prev(commands.end(), 2) == prev) {
+        delete curCmd->removeChild();
+    }
 }
 
 //---------------------------------------------------------
@@ -381,6 +485,7 @@ void UndoStack::remove(size_t idx)
     while (list.size() > curIdx) {
         UndoCommand* cmd = mu::takeLast(list);
         stateList.pop_back();
+        takeMemoryUsage(cmd, false);
         cmd->cleanup(false);      // delete elements for which UndoCommand() holds ownership
         delete cmd;
 //            --curIdx;
@@ -388,6 +493,7 @@ void UndoStack::remove(size_t idx)
     while (list.size() > idx) {
         UndoCommand* cmd = mu::takeLast(list);
         stateList.pop_back();
+        takeMemoryUsage(cmd, true);
         cmd->cleanup(true);
         delete cmd;
     }
@@ -400,6 +506,11 @@ void UndoStack::remove(size_t idx)
 
 void UndoStack::mergeCommands(size_t startIdx)
 {
+    // indices given out count the evicted macros too
+    IF_ASSERT_FAILED(startIdx >= m_evictedCount) {
+        return;
+    }
+    startIdx -= m_evictedCount;
     assert(startIdx <= curIdx);
 
     if (startIdx >= list.size()) {
@@ -451,14 +562,20 @@ void UndoStack::endMacro(bool rollback)
         while (list.size() > curIdx) {
             UndoCommand* cmd = mu::takeLast(list);
             stateList.pop_back();
+            takeMemoryUsage(cmd, false);
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
         list.push_back(curCmd);
         stateList.push_back(nextState++);
         ++curIdx;
+
+        curCmd->updateMemoryUsage();
+        m_memoryUsage += curCmd->memoryUsage(true);
     }
     curCmd = 0;
+
+    evictOldest();
 }
 
 //---------------------------------------------------------
@@ -477,6 +594,7 @@ void UndoStack::reopen()
     --curIdx;
     curCmd = mu::takeAt(list, curIdx);
     stateList.erase(stateList.begin() + curIdx);
+    takeMemoryUsage(curCmd, true);
     for (auto i : curCmd->commands()) {
         LOG_UNDO() << "   " << i->name();
     }
@@ -492,7 +610,7 @@ void UndoStack::undo(EditData* ed)
     // Are we currently editing text?
     if (ed && ed->element && ed->element->isTextBase()) {
         TextEditData* ted = static_cast<TextEditData*>(ed->getData(ed->element).get());
-        if (ted && ted->startUndoIdx == curIdx) {
+        if (ted && ted->startUndoIdx == getCurIdx()) {
             // No edits to undo, so do nothing
             return;
         }
@@ -501,6 +619,9 @@ void UndoStack::undo(EditData* ed)
         --curIdx;
         assert(curIdx < list.size());
         list[curIdx]->undo(ed);
+
+        takeMemoryUsage(list[curIdx], true);
+        m_memoryUsage += list[curIdx]->memoryUsage(false);
     }
 }
 
@@ -512,7 +633,11 @@ void UndoStack::redo(EditData* ed)
 {
     LOG_UNDO() << "called";
     if (canRedo()) {
-        list[curIdx++]->redo(ed);
+        UndoMacro* cmd = list[curIdx++];
+        cmd->redo(ed);
+
+        takeMemoryUsage(cmd, false);
+        m_memoryUsage += cmd->memoryUsage(true);
     }
 }
 
@@ -602,9 +727,19 @@ bool UndoMacro::empty() const
     return childCount() == 0;
 }
 
+void UndoMacro::updateMemoryUsage()
+{
+    m_doneMemoryUsage = sizeof(UndoMacro) - sizeof(UndoCommand) + UndoCommand::memoryUsage(true);
+    m_undoneMemoryUsage = sizeof(UndoMacro) - sizeof(UndoCommand) + UndoCommand::memoryUsage(false);
+}
+
 void UndoMacro::append(UndoMacro&& other)
 {
     appendChildren(&other);
+    m_doneMemoryUsage += other.m_doneMemoryUsage;
+    m_undoneMemoryUsage += other.m_undoneMemoryUsage;
+    other.m_doneMemoryUsage = 0;
+    other.m_undoneMemoryUsage = 0;
     if (m_score == other.m_score) {
         m_redoInputState = std::move(other.m_redoInputState);
         m_redoSelectionInfo = std::move(other.m_redoSelectionInfo);
@@ -796,6 +931,12 @@ void AddElement::cleanup(bool undo)
     }
 }
 
+size_t AddElement::memoryUsage(bool done) const
+{
+    //! NOTE The added item belongs to the score until the command is undone
+    return UndoCommand::memoryUsage(done) + (done ? 0 : itemTreeMemoryUsage(element));
+}
+
 //---------------------------------------------------------
 //   undoRemoveTuplet
 //---------------------------------------------------------
@@ -992,6 +1133,12 @@ void RemoveElement::cleanup(bool undo)
     }
 }
 
+size_t RemoveElement::memoryUsage(bool done) const
+{
+    //! NOTE The removed item only belongs to the command while it is done
+    return UndoCommand::memoryUsage(done) + (done ? itemTreeMemoryUsage(element) : 0);
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -2418,6 +2565,11 @@ std::vector<const EngravingObject*> ChangeProperty::objectItems() const
     return compoundObjects(element);
 }
 
+size_t ChangeProperty::memoryUsage(bool done) const
+{
+    return UndoCommand::memoryUsage(done) + sizeof(ChangeProperty) - sizeof(UndoCommand);
+}
+
 //---------------------------------------------------------
 //   ChangeBracketProperty::flip
 //---------------------------------------------------------
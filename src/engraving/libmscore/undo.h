@@ -126,6 +126,7 @@ public:
     const std::list<UndoCommand*>& commands() const { return childList; }
     virtual std::vector<const EngravingObject*> objectItems() const { return {}; }
     virtual void cleanup(bool undo);
+    virtual size_t memoryUsage(bool done) const;
 // #ifndef QT_NO_DEBUG
     virtual const char* name() const { return "UndoCommand"; }
 // #endif
@@ -163,6 +164,9 @@ public:
     bool empty() const;
     void append(UndoMacro&& other);
 
+    size_t memoryUsage(bool done) const override { return done ? m_doneMemoryUsage : m_undoneMemoryUsage; }
+    void updateMemoryUsage();
+
     const InputState& undoInputState() const;
     const InputState& redoInputState() const;
     const SelectionInfo& undoSelectionInfo() const;
@@ -188,6 +192,8 @@ private:
     SelectionInfo m_redoSelectionInfo;
 
     Score* m_score = nullptr;
+    size_t m_doneMemoryUsage = 0;
+    size_t m_undoneMemoryUsage = 0;
 
     static void fillSelectionInfo(SelectionInfo&, const Selection&);
     static void applySelectionInfo(const SelectionInfo&, Selection&);
@@ -203,7 +209,15 @@ class UndoStack
     size_t curIdx = 0;
     bool isLocked = false;
 
+    size_t m_memoryUsage = 0;
+    size_t m_maxSteps = 0;            // 0 means no limit
+    size_t m_maxMemoryUsage = 0;      // 0 means no limit
+    size_t m_evictedCount = 0;        // macros dropped from the bottom, keeps the indices given out valid
+    size_t m_mergeStartIdx = mu::nidx; // macros from here on are about to be merged, they are never evicted
+
     void remove(size_t idx);
+    void evictOldest();
+    void takeMemoryUsage(const UndoCommand* cmd, bool done);
 
 public:
     UndoStack();
@@ -220,7 +234,7 @@ public:
     bool canUndo() const { return curIdx > 0; }
     bool canRedo() const { return curIdx < list.size(); }
     bool isClean() const { return cleanState == stateList[curIdx]; }
-    size_t getCurIdx() const { return curIdx; }
+    size_t getCurIdx() const { return m_evictedCount + curIdx; }
     UndoMacro* current() const { return curCmd; }
     UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
     UndoMacro* prev() const { return curIdx > 1 ? list[curIdx - 2] : 0; }
@@ -229,7 +243,12 @@ public:
     void reopen();
 
     void mergeCommands(size_t startIdx);
+    void setMergeStartIdx(size_t idx) { m_mergeStartIdx = idx; }
+    void resetMergeStartIdx() { m_mergeStartIdx = mu::nidx; }
     void cleanRedoStack() { remove(curIdx); }
+
+    size_t memoryUsage() const { return m_memoryUsage; }
+    void setLimits(size_t maxSteps, size_t maxMemoryUsage);
 };
 
 class InsertPart : public UndoCommand
@@ -612,6 +631,7 @@ public:
     AddElement(EngravingItem*);
     EngravingItem* getElement() const { return element; }
     void cleanup(bool) override;
+    size_t memoryUsage(bool done) const override;
     const char* name() const override;
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override;
@@ -632,6 +652,7 @@ public:
     void undo(EditData*) override;
     void redo(EditData*) override;
     void cleanup(bool) override;
+    size_t memoryUsage(bool done) const override;
     const char* name() const override;
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override;
@@ -1095,6 +1116,8 @@ public:
     EngravingObject* getElement() const { return element; }
     PropertyValue data() const { return property; }
 
+    size_t memoryUsage(bool done) const override;
+
     UNDO_TYPE(CommandType::ChangeProperty)
     UNDO_NAME("ChangeProperty")
 
@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "internal/engravingfont.h"
+#include "io/file.h"
+#include "types/symnames.h"
+
+#include "mocks/engravingconfigurationmock.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+using ::testing::Return;
+
+static const io::path_t METRICS_CACHE_DIR("engravingfont_metrics_cache");
+static const io::path_t BRAVURA_PATH(":/fonts/bravura/Bravura.otf");
+
+class Engraving_EngravingFontTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_oldConfiguration = EngravingFont::configuration();
+
+        auto configuration = std::make_shared<::testing::NiceMock<EngravingConfigurationMock> >();
+        ON_CALL(*configuration, engravingFontsCachePath()).WillByDefault(Return(METRICS_CACHE_DIR));
+        EngravingFont::setconfiguration(configuration);
+    }
+
+    void TearDown() override
+    {
+        EngravingFont::setconfiguration(m_oldConfiguration);
+    }
+
+    std::shared_ptr<IEngravingConfiguration> m_oldConfiguration;
+};
+
+static void checkSameMetrics(const EngravingFont& expected, const EngravingFont& actual)
+{
+    for (size_t i = 0; i <= static_cast<size_t>(SymId::lastSym); ++i) {
+        SymId id = static_cast<SymId>(i);
+        EXPECT_EQ(expected.symCode(id), actual.symCode(id)) << SymNames::nameForSymId(id).ascii();
+        EXPECT_EQ(expected.bbox(id, 1.0), actual.bbox(id, 1.0)) << SymNames::nameForSymId(id).ascii();
+        EXPECT_DOUBLE_EQ(expected.advance(id, 1.0), actual.advance(id, 1.0)) << SymNames::nameForSymId(id).ascii();
+        for (SmuflAnchorId anchor : { SmuflAnchorId::stemDownNW, SmuflAnchorId::stemUpSE, SmuflAnchorId::opticalCenter }) {
+            EXPECT_EQ(expected.smuflAnchor(id, anchor, 1.0), actual.smuflAnchor(id, anchor, 1.0));
+        }
+    }
+
+    std::unordered_map<Sid, PropertyValue> expectedDefaults = expected.engravingDefaults();
+    std::unordered_map<Sid, PropertyValue> actualDefaults = actual.engravingDefaults();
+    EXPECT_EQ(expectedDefaults.size(), actualDefaults.size());
+    for (const auto& pair : expectedDefaults) {
+        EXPECT_EQ(pair.second, actualDefaults[pair.first]);
+    }
+}
+
+TEST_F(Engraving_EngravingFontTests, metricsCache)
+{
+    io::path_t cacheFilePath = METRICS_CACHE_DIR + "/Bravura.metrics";
+    io::File::remove(cacheFilePath);
+
+    //! GIVEN Font loaded without cache, it writes the cache
+    EngravingFont computed("Bravura", "Bravura", BRAVURA_PATH);
+    computed.ensureLoad();
+    EXPECT_TRUE(io::File::exists(cacheFilePath));
+
+    //! DO The same font is loaded again
+    EngravingFont cached("Bravura", "Bravura", BRAVURA_PATH);
+    cached.ensureLoad();
+
+    //! CHECK Metrics from the cache are the same as computed ones
+    checkSameMetrics(computed, cached);
+
+    //! DO The cache is corrupted
+    ByteArray data;
+    io::File::readFile(cacheFilePath, data);
+    io::File::writeFile(cacheFilePath, data.left(data.size() / 2));
+
+    EngravingFont recomputed("Bravura", "Bravura", BRAVURA_PATH);
+    recomputed.ensureLoad();
+
+    //! CHECK Metrics are computed again
+    checkSameMetrics(computed, recomputed);
+
+    io::File::remove(cacheFilePath);
+}
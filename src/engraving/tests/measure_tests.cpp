@@ -552,3 +552,48 @@ TEST_F(Engraving_MeasureTests, measureNumbers)
 
     delete score;
 }
+
+TEST_F(Engraving_MeasureTests, segmentElementsSkipEmptyTracks)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-1.mscx");
+    EXPECT_TRUE(score);
+
+    auto checkSegment = [](const Segment* s) {
+        std::vector<EngravingItem*> expected;
+        for (EngravingItem* e : s->elist()) {
+            if (e) {
+                expected.push_back(e);
+            }
+        }
+
+        std::vector<EngravingItem*> actual;
+        for (EngravingItem* e : s->elements()) {
+            actual.push_back(e);
+        }
+
+        EXPECT_EQ(actual, expected);
+    };
+
+    for (Segment* s = score->firstSegment(SegmentType::All); s; s = s->next1()) {
+        checkSegment(s);
+    }
+
+    // clearing a track must drop it from the iteration
+    Segment* s = score->firstSegment(SegmentType::ChordRest);
+    EngravingItem* e = s->element(0);
+    EXPECT_TRUE(e);
+    s->setElement(0, nullptr);
+    checkSegment(s);
+    s->setElement(0, e);
+    checkSegment(s);
+
+    // inserting a staff shifts the occupied tracks
+    s->insertStaff(0);
+    checkSegment(s);
+    EXPECT_EQ(s->element(VOICES), e);
+    s->removeStaff(0);
+    checkSegment(s);
+    EXPECT_EQ(s->element(0), e);
+
+    delete score;
+}
@@ -32,6 +32,8 @@ class EngravingConfigurationMock : public IEngravingConfiguration
 public:
     MOCK_METHOD(io::path_t, appDataPath, (), (const, override));
 
+    MOCK_METHOD(io::path_t, engravingFontsCachePath, (), (const, override));
+
     MOCK_METHOD(io::path_t, defaultStyleFilePath, (), (const, override));
     MOCK_METHOD(void, setDefaultStyleFilePath, (const io::path_t&), (override));
 
@@ -72,6 +74,10 @@ public:
 
     MOCK_METHOD(bool, isAccessibleEnabled, (), (const, override));
 
+    MOCK_METHOD(size_t, undoHistoryMaxSteps, (), (const, override));
+    MOCK_METHOD(size_t, undoHistoryMaxMemoryUsage, (), (const, override));
+    MOCK_METHOD(async::Notification, undoHistoryLimitsChanged, (), (const, override));
+
     MOCK_METHOD(bool, guitarProImportExperimental, (), (const, override));
     MOCK_METHOD(bool, negativeFretsAllowed, (), (const, override));
     MOCK_METHOD(bool, tablatureParenthesesZIndexWorkaround, (), (const, override));
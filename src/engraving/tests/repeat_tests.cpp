@@ -25,6 +25,7 @@
 #include "libmscore/masterscore.h"
 #include "libmscore/measure.h"
 #include "libmscore/repeatlist.h"
+#include "libmscore/tempo.h"
 
 #include "utils/scorerw.h"
 
@@ -415,3 +416,36 @@ TEST_F(Engraving_RepeatTests, repeat68) {
     // Entire score skipped by volta: gh#14685
     repeat("repeat68.mscx", u"");
 }
+
+TEST_F(Engraving_RepeatTests, tickConversions) {
+    // complex roadmap DS al coda, volta, repeat: lookups must match a linear scan of the segments
+    MasterScore* score = ScoreRW::readScore(REPEAT_DATA_DIR + u"repeat14.mscx");
+    ASSERT_TRUE(score);
+
+    score->setExpandRepeats(true);
+    const RepeatList& repeatList = score->repeatList();
+    ASSERT_FALSE(repeatList.empty());
+
+    for (const RepeatSegment* rs : repeatList) {
+        for (int tick = rs->tick; tick < rs->tick + rs->len(); tick += Constants::division / 2) {
+            const RepeatSegment* first = nullptr;
+            for (const RepeatSegment* s : repeatList) {
+                if (tick >= s->tick && tick < s->tick + s->len()) {
+                    first = s;
+                    break;
+                }
+            }
+            ASSERT_TRUE(first);
+            EXPECT_EQ(repeatList.tick2utick(tick), first->utick + (tick - first->tick));
+
+            int utick = rs->utick + (tick - rs->tick);
+            EXPECT_EQ(repeatList.utick2tick(utick), tick);
+
+            double utime = repeatList.utick2utime(utick);
+            EXPECT_DOUBLE_EQ(utime, score->tempomap()->tick2time(tick) + rs->timeOffset);
+            EXPECT_EQ(repeatList.utime2utick(utime), utick);
+        }
+    }
+
+    delete score;
+}
@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/breath.h"
+#include "libmscore/clef.h"
+#include "libmscore/factory.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class Engraving_ShapeTests : public ::testing::Test
+{
+};
+
+TEST_F(Engraving_ShapeTests, minHorizontalDistance_WithoutItems)
+{
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    ASSERT_TRUE(score);
+
+    //! GIVEN Rectangles that don't belong to items and don't overlap vertically
+    Shape left;
+    left.add(RectF(0.0, 0.0, 10.0, 10.0));
+    Shape right;
+    right.add(RectF(3.0, 50.0, 5.0, 5.0));
+
+    //! CHECK They can't kern, right must start where left ends
+    EXPECT_DOUBLE_EQ(left.minHorizontalDistance(right, score), 7.0);
+
+    delete score;
+}
+
+TEST_F(Engraving_ShapeTests, minHorizontalDistance_Items)
+{
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    ASSERT_TRUE(score);
+    const double sp = score->spatium();
+
+    Segment* segment = score->dummy()->segment();
+    Clef* clef1 = Factory::createClef(segment);
+    Clef* clef2 = Factory::createClef(segment);
+    Breath* breath1 = Factory::createBreath(segment);
+    breath1->setTrack(0);
+    Breath* breath2 = Factory::createBreath(segment);
+    breath2->setTrack(0);
+    Breath* otherVoiceBreath = Factory::createBreath(segment);
+    otherVoiceBreath->setTrack(1);
+
+    ASSERT_DOUBLE_EQ(clef1->mag(), 1.0);
+    ASSERT_DOUBLE_EQ(breath1->mag(), 1.0);
+
+    //! CHECK Clefs are never kerned, even without vertical overlap; the clef->clef padding is 0.75sp
+    Shape clefShape1;
+    clefShape1.add(RectF(0.0, -2.0 * sp, 2.0 * sp, 4.0 * sp), clef1);
+    Shape clefShape2;
+    clefShape2.add(RectF(0.0, 10.0 * sp, 2.0 * sp, 4.0 * sp), clef2);
+    EXPECT_DOUBLE_EQ(clefShape1.minHorizontalDistance(clefShape2, score), 2.75 * sp);
+
+    //! CHECK Breaths of the same voice are never kerned; the padding to and from a breath is 1sp
+    Shape breathShape;
+    breathShape.add(RectF(0.0, 0.0, sp, sp), breath1);
+    Shape sameVoiceShape;
+    sameVoiceShape.add(RectF(0.0, 10.0 * sp, sp, sp), breath2);
+    EXPECT_DOUBLE_EQ(breathShape.minHorizontalDistance(sameVoiceShape, score), 2.0 * sp);
+
+    //! CHECK Breaths of different voices are kerned when they don't overlap vertically...
+    Shape otherVoiceShape;
+    otherVoiceShape.add(RectF(0.0, 10.0 * sp, sp, sp), otherVoiceBreath);
+    EXPECT_LT(breathShape.minHorizontalDistance(otherVoiceShape, score), 0.0);
+
+    //! CHECK ...and padded when they do
+    otherVoiceShape.add(RectF(0.0, 0.5 * sp, sp, sp), otherVoiceBreath);
+    EXPECT_DOUBLE_EQ(breathShape.minHorizontalDistance(otherVoiceShape, score), 2.0 * sp);
+
+    //! CHECK A zero-width rectangle collides with everything
+    Shape zeroWidthShape;
+    zeroWidthShape.add(RectF(0.5 * sp, 10.0 * sp, 0.0, sp), otherVoiceBreath);
+    EXPECT_DOUBLE_EQ(breathShape.minHorizontalDistance(zeroWidthShape, score), 1.5 * sp);
+
+    delete clef1;
+    delete clef2;
+    delete breath1;
+    delete breath2;
+    delete otherVoiceBreath;
+    delete score;
+}
@@ -256,3 +256,34 @@ TEST_F(Engraving_TempoMapTests, GRADUAL_TEMPO_CHANGE_DOESNT_OVERWRITE_OTHER_TEMP
         EXPECT_TRUE(RealIsEqual(RealRound(tempoMap->at(pair.first).tempo.val, 2), RealRound(pair.second.val, 2)));
     }
 }
+
+/**
+ * @brief TempoMapTests_BATCH_CONVERSION
+ * @details In this case we're loading the score with the "accelerando" above measures 5 and 6,
+ *          and converting every eighth note of it to time in one batch
+ */
+TEST_F(Engraving_TempoMapTests, BATCH_CONVERSION)
+{
+    // [GIVEN] Simple piece of score (Violin, 4/4, 120 bpm, Treble Cleff) with a gradual tempo change
+    Score* score
+        = ScoreRW::readScore(TEMPOMAP_TEST_FILES_DIR + "gradual_tempo_change_accelerando/gradual_tempo_change_accelerando.mscx");
+
+    ASSERT_TRUE(score);
+
+    // [GIVEN] Sorted ticks of every eighth note
+    std::vector<int> ticks;
+    for (int tick = 0; tick <= 8 * 4 * Constants::division; tick += Constants::division / 2) {
+        ticks.push_back(tick);
+    }
+
+    // [WHEN] We convert them in one batch
+    const TempoMap* tempoMap = score->tempomap();
+    std::vector<double> times = tempoMap->ticks2times(ticks);
+
+    // [THEN] Every time matches the one converted separately, and converts back to the same tick
+    ASSERT_EQ(times.size(), ticks.size());
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        EXPECT_DOUBLE_EQ(times[i], tempoMap->tick2time(ticks[i]));
+        EXPECT_EQ(tempoMap->time2tick(times[i]), ticks[i]);
+    }
+}
@@ -192,3 +192,47 @@ TEST_F(Engraving_TextBaseTests, musicalSymbolsNotItalic)
     EXPECT_TRUE(fragmentList.front().font(dynamic).italic());
     EXPECT_TRUE(!std::next(fragmentList.begin())->font(dynamic).italic());
 }
+
+TEST_F(Engraving_TextBaseTests, shapingCache)
+{
+    MasterScore* score = ScoreRW::readScore(u"test.mscx");
+    const String text = u"<b>Allegro <sym>metNoteQuarterUp</sym> = 120</b>\nmolto <i>rit.</i>";
+
+    //! GIVEN Texts with the same content, the second one is shaped from the cache
+    StaffText* staffText1 = addStaffText(score);
+    staffText1->setXmlText(text);
+    staffText1->layout();
+
+    StaffText* staffText2 = addStaffText(score);
+    staffText2->setXmlText(text);
+    staffText2->layout();
+
+    //! GIVEN A text with the same content shaped without the cache
+    score->textShapingCache()->clear();
+    StaffText* staffText3 = addStaffText(score);
+    staffText3->setXmlText(text);
+    staffText3->layout();
+
+    //! CHECK The layouts are the same
+    for (const StaffText* staffText : { staffText1, staffText2 }) {
+        EXPECT_EQ(staffText->xmlText(), staffText3->xmlText());
+        EXPECT_EQ(staffText->bbox(), staffText3->bbox());
+        ASSERT_EQ(staffText->rows(), staffText3->rows());
+
+        for (size_t row = 0; row < staffText->rows(); ++row) {
+            const TextBlock& block = staffText->textBlock(static_cast<int>(row));
+            const TextBlock& expectedBlock = staffText3->textBlock(static_cast<int>(row));
+            EXPECT_EQ(block.boundingRect(), expectedBlock.boundingRect());
+            EXPECT_EQ(block.lineSpacing(), expectedBlock.lineSpacing());
+            ASSERT_EQ(block.fragments().size(), expectedBlock.fragments().size());
+
+            auto expected = expectedBlock.fragments().cbegin();
+            for (const TextFragment& fragment : block.fragments()) {
+                EXPECT_EQ(fragment.text, expected->text);
+                EXPECT_TRUE(fragment.format == expected->format);
+                EXPECT_EQ(fragment.pos, expected->pos);
+                ++expected;
+            }
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "libmscore/chord.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/note.h"
+#include "libmscore/segment.h"
+#include "libmscore/undo.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String UNDOSTACK_DATA_DIR("measure_data/");
+
+class Engraving_UndoStackTests : public ::testing::Test
+{
+};
+
+static Note* firstNote(Score* score)
+{
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        EngravingItem* e = s->element(0);
+        if (e && e->isChord()) {
+            return toChord(e)->upNote();
+        }
+    }
+
+    return nullptr;
+}
+
+TEST_F(Engraving_UndoStackTests, coalescePropertyChanges)
+{
+    MasterScore* score = ScoreRW::readScore(UNDOSTACK_DATA_DIR + u"measure-1.mscx");
+    ASSERT_TRUE(score);
+
+    Note* note = firstNote(score);
+    ASSERT_TRUE(note);
+    PropertyValue oldColor = note->getProperty(Pid::COLOR);
+
+    // [GIVEN] Consecutive changes of the same property in one command
+    score->startCmd();
+    note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(mu::draw::Color(255, 0, 0, 255)));
+    note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(mu::draw::Color(0, 255, 0, 255)));
+    note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(mu::draw::Color(0, 0, 255, 255)));
+    score->endCmd();
+
+    // [THEN] They are kept as one change
+    UndoMacro* macro = score->undoStack()->last();
+    ASSERT_TRUE(macro);
+    EXPECT_EQ(macro->childCount(), 1);
+    EXPECT_EQ(note->getProperty(Pid::COLOR), PropertyValue::fromValue(mu::draw::Color(0, 0, 255, 255)));
+
+    // [THEN] Undo restores the first old value, redo the last new one
+    score->undoStack()->undo(nullptr);
+    EXPECT_EQ(note->getProperty(Pid::COLOR), oldColor);
+
+    score->undoStack()->redo(nullptr);
+    EXPECT_EQ(note->getProperty(Pid::COLOR), PropertyValue::fromValue(mu::draw::Color(0, 0, 255, 255)));
+
+    delete score;
+}
+
+TEST_F(Engraving_UndoStackTests, evictOldestOverStepLimit)
+{
+    MasterScore* score = ScoreRW::readScore(UNDOSTACK_DATA_DIR + u"measure-1.mscx");
+    ASSERT_TRUE(score);
+
+    Note* note = firstNote(score);
+    ASSERT_TRUE(note);
+
+    UndoStack* undoStack = score->undoStack();
+    undoStack->setLimits(3, 0);
+
+    // [GIVEN] Five commands with a limit of three steps
+    for (int i = 0; i < 5; ++i) {
+        score->startCmd();
+        note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(mu::draw::Color(i * 50, 0, 0, 255)));
+        score->endCmd();
+    }
+
+    // [THEN] Only the last three can be undone, the indices given out still count all five
+    EXPECT_EQ(undoStack->getCurIdx(), 5);
+    EXPECT_GT(undoStack->memoryUsage(), 0);
+
+    int undone = 0;
+    while (undoStack->canUndo()) {
+        undoStack->undo(nullptr);
+        ++undone;
+    }
+    EXPECT_EQ(undone, 3);
+    EXPECT_EQ(note->getProperty(Pid::COLOR), PropertyValue::fromValue(mu::draw::Color(50, 0, 0, 255)));
+
+    delete score;
+}
+
+TEST_F(Engraving_UndoStackTests, keepMacrosToBeMerged)
+{
+    MasterScore* score = ScoreRW::readScore(UNDOSTACK_DATA_DIR + u"measure-1.mscx");
+    ASSERT_TRUE(score);
+
+    Note* note = firstNote(score);
+    ASSERT_TRUE(note);
+
+    UndoStack* undoStack = score->undoStack();
+    undoStack->setLimits(2, 0);
+
+    // [GIVEN] Commands which are going to be merged, more than the limit allows
+    score->startCmd();
+    note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(mu::draw::Color(0, 0, 0, 255)));
+    score->endCmd();
+
+    size_t mergeStartIdx = undoStack->getCurIdx();
+    undoStack->setMergeStartIdx(mergeStartIdx);
+
+    for (int i = 1; i < 5; ++i) {
+        score->startCmd();
+        note->undoChangeProperty(Pid::COLOR, PropertyValue::fromValue(mu::draw::Color(i * 50, 0, 0, 255)));
+        score->endCmd();
+    }
+
+    // [WHEN] They are merged
+    undoStack->mergeCommands(mergeStartIdx);
+    undoStack->resetMergeStartIdx();
+
+    // [THEN] None of them was evicted, one undo goes back to the state before them
+    undoStack->undo(nullptr);
+    EXPECT_EQ(note->getProperty(Pid::COLOR), PropertyValue::fromValue(mu::draw::Color(0, 0, 0, 255)));
+
+    delete score;
+}
@@ -0,0 +1,255 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "polyphaseresampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define MU_AUDIO_RESAMPLER_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MU_AUDIO_RESAMPLER_NEON
+#endif
+
+#include "log.h"
+
+using namespace mu::audio;
+using namespace mu::audio::dsp;
+
+static constexpr unsigned int TAPS = PolyphaseResampler::TAPS_PER_PHASE;
+static constexpr unsigned int HISTORY = TAPS - 1;
+static constexpr double KAISER_BETA = 9.0; //!< ~90 dB stopband attenuation
+static constexpr double ROLLOFF = 0.92;    //!< passband edge relative to the lower Nyquist frequency
+
+static_assert(TAPS % 4 == 0, "the inner product is unrolled by four");
+
+static inline float dotProduct(const float* coeffs, const float* samples)
+{
+#if defined(MU_AUDIO_RESAMPLER_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (unsigned int i = 0; i < TAPS; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(coeffs + i), _mm_loadu_ps(samples + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(coeffs + i + 4), _mm_loadu_ps(samples + i + 4)));
+    }
+    __m128 acc = _mm_add_ps(acc0, acc1);
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 0x55));
+    return _mm_cvtss_f32(acc);
+#elif defined(MU_AUDIO_RESAMPLER_NEON)
+    float32x4_t acc = vdupq_n_f32(0.f);
+    for (unsigned int i = 0; i < TAPS; i += 4) {
+        acc = vmlaq_f32(acc, vld1q_f32(coeffs + i), vld1q_f32(samples + i));
+    }
+    float32x2_t sum = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    return vget_lane_f32(vpadd_f32(sum, sum), 0);
+#else
+    float acc[4] = { 0.f, 0.f, 0.f, 0.f };
+    for (unsigned int i = 0; i < TAPS; i += 4) {
+        acc[0] += coeffs[i] * samples[i];
+        acc[1] += coeffs[i + 1] * samples[i + 1];
+        acc[2] += coeffs[i + 2] * samples[i + 2];
+        acc[3] += coeffs[i + 3] * samples[i + 3];
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif
+}
+
+static double besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 64; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+PolyphaseResampler::PolyphaseResampler(audioch_t channels, unsigned int sampleRateIn, unsigned int sampleRateOut,
+                                       samples_t maxInputFrames)
+    : m_channels(channels), m_blockSize(std::max<samples_t>(maxInputFrames, 1))
+{
+    IF_ASSERT_FAILED(sampleRateIn > 0 && sampleRateOut > 0) {
+        sampleRateIn = sampleRateOut = 1;
+    }
+
+    initFilterBank(sampleRateIn, sampleRateOut);
+
+    m_history.resize(m_channels);
+    for (std::vector<float>& history : m_history) {
+        history.resize(HISTORY + m_blockSize, 0.f);
+    }
+}
+
+audioch_t PolyphaseResampler::channels() const
+{
+    return m_channels;
+}
+
+unsigned int PolyphaseResampler::upFactor() const
+{
+    return m_L;
+}
+
+unsigned int PolyphaseResampler::downFactor() const
+{
+    return m_M;
+}
+
+void PolyphaseResampler::initFilterBank(unsigned int sampleRateIn, unsigned int sampleRateOut)
+{
+    unsigned int divisor = std::gcd(sampleRateIn, sampleRateOut);
+    m_L = sampleRateOut / divisor;
+    m_M = sampleRateIn / divisor;
+
+    //! NOTE: ratios like 44100 -> 48000 (160/147) get a sub-filter per phase;
+    //! very large L (odd rates) are quantized to MAX_PHASES phases, which is far below audible error
+    m_phases = std::min(m_L, MAX_PHASES);
+
+    //! the prototype is evaluated in input sample units: x(t) = sum x[k] * h(t - k)
+    const double cutoff = 0.5 * std::min(1.0, static_cast<double>(sampleRateOut) / sampleRateIn) * ROLLOFF;
+    const double halfLength = TAPS / 2.0;
+    const double windowNorm = besselI0(KAISER_BETA);
+
+    m_bank.assign(static_cast<size_t>(m_phases) * TAPS, 0.f);
+
+    std::vector<double> row(TAPS);
+    for (unsigned int p = 0; p < m_phases; ++p) {
+        const double fraction = static_cast<double>(p) / m_phases;
+
+        double sum = 0.0;
+        for (unsigned int k = 0; k < TAPS; ++k) {
+            //! tap k weights input frame (i - k) of an output at i + fraction - delay()
+            double t = k + fraction - halfLength;
+            double x = 2.0 * cutoff * t;
+            double sinc = (x == 0.0) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+            double r = t / halfLength;
+            double window = (std::abs(r) >= 1.0) ? 0.0 : besselI0(KAISER_BETA * std::sqrt(1.0 - r * r)) / windowNorm;
+
+            row[k] = 2.0 * cutoff * sinc * window;
+            sum += row[k];
+        }
+
+        //! unity gain at DC for every phase
+        float* dst = &m_bank[static_cast<size_t>(p) * TAPS];
+        for (unsigned int k = 0; k < TAPS; ++k) {
+            dst[HISTORY - k] = static_cast<float>(row[k] / sum);
+        }
+    }
+}
+
+const float* PolyphaseResampler::coefficients(unsigned int phase) const
+{
+    size_t row = (m_phases == m_L) ? phase : static_cast<size_t>((static_cast<uint64_t>(phase) * m_phases) / m_L);
+    return &m_bank[row * TAPS];
+}
+
+void PolyphaseResampler::reset(unsigned int phase, const float* history)
+{
+    m_filled = 0;
+    m_index = 0;
+    m_phase = phase % m_L;
+
+    for (audioch_t c = 0; c < m_channels; ++c) {
+        float* dst = m_history[c].data();
+        if (!history) {
+            std::fill(dst, dst + HISTORY, 0.f);
+            continue;
+        }
+
+        for (unsigned int s = 0; s < HISTORY; ++s) {
+            dst[s] = history[s * m_channels + c];
+        }
+    }
+}
+
+void PolyphaseResampler::deinterleave(const float* input, samples_t frames)
+{
+    for (audioch_t c = 0; c < m_channels; ++c) {
+        float* dst = m_history[c].data() + HISTORY + m_filled;
+        const float* src = input + c;
+        for (samples_t s = 0; s < frames; ++s) {
+            dst[s] = src[s * m_channels];
+        }
+    }
+
+    m_filled += frames;
+}
+
+void PolyphaseResampler::shiftHistory()
+{
+    for (std::vector<float>& history : m_history) {
+        std::memmove(history.data(), history.data() + m_filled, HISTORY * sizeof(float));
+    }
+
+    m_index -= m_filled;
+    m_filled = 0;
+}
+
+samples_t PolyphaseResampler::process(const float* input, samples_t inputFrames, samples_t& consumedFrames,
+                                      float* output, samples_t outputFrames)
+{
+    consumedFrames = 0;
+    samples_t produced = 0;
+
+    while (true) {
+        while (produced < outputFrames && m_index < m_filled) {
+            //! history[m_index .. m_index + TAPS) are the input frames (i - TAPS + 1 .. i)
+            const float* coeffs = coefficients(m_phase);
+            float* out = output + produced * m_channels;
+            for (audioch_t c = 0; c < m_channels; ++c) {
+                out[c] = dotProduct(coeffs, m_history[c].data() + m_index);
+            }
+
+            ++produced;
+            m_phase += m_M;
+            m_index += m_phase / m_L;
+            m_phase %= m_L;
+        }
+
+        if (produced == outputFrames) {
+            break;
+        }
+
+        if (m_filled > 0) {
+            shiftHistory();
+        }
+
+        if (consumedFrames == inputFrames) {
+            break;
+        }
+
+        samples_t frames = std::min(inputFrames - consumedFrames, m_blockSize);
+        deinterleave(input + consumedFrames * m_channels, frames);
+        consumedFrames += frames;
+    }
+
+    return produced;
+}
@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_POLYPHASERESAMPLER_H
+#define MU_AUDIO_POLYPHASERESAMPLER_H
+
+#include <vector>
+
+#include "audiotypes.h"
+
+namespace mu::audio::dsp {
+//! Streaming rational sample rate converter.
+//! The rate ratio is reduced to L/M; the Kaiser windowed sinc prototype is split into
+//! min(L, MAX_PHASES) sub-filters of TAPS_PER_PHASE taps, so every output frame costs
+//! one TAPS_PER_PHASE long inner product per channel, independent of L and M.
+//! Input history is kept deinterleaved per channel in preallocated buffers,
+//! so process() never allocates and can run on the audio thread.
+class PolyphaseResampler
+{
+public:
+    static constexpr unsigned int TAPS_PER_PHASE = 48;
+    static constexpr unsigned int MAX_PHASES = 1024;
+
+    //! maxInputFrames limits how many frames are deinterleaved at once, not the size of process() calls
+    PolyphaseResampler(audioch_t channels, unsigned int sampleRateIn, unsigned int sampleRateOut,
+                       samples_t maxInputFrames = 1024);
+
+    audioch_t channels() const;
+    unsigned int upFactor() const;
+    unsigned int downFactor() const;
+
+    //! number of input frames the filter lags behind, the first output frame
+    //! that corresponds to input frame 0 is produced after this many frames of input
+    static constexpr unsigned int delay() { return TAPS_PER_PHASE / 2; }
+
+    //! drop all the streaming state.
+    //! phase is the position of the next output frame between two input frames, in units of 1/upFactor().
+    //! history (interleaved, TAPS_PER_PHASE - 1 frames) are the input frames preceding the next process() call,
+    //! nullptr means silence
+    void reset(unsigned int phase = 0, const float* history = nullptr);
+
+    //! consumes up to inputFrames interleaved frames and writes up to outputFrames interleaved frames.
+    //! consumedFrames receives the number of input frames taken, the return value is the number of frames written.
+    //! Frames which were consumed, but didn't fit into the output are produced by the next call
+    samples_t process(const float* input, samples_t inputFrames, samples_t& consumedFrames, float* output, samples_t outputFrames);
+
+private:
+    void initFilterBank(unsigned int sampleRateIn, unsigned int sampleRateOut);
+    const float* coefficients(unsigned int phase) const;
+    void deinterleave(const float* input, samples_t frames);
+    void shiftHistory();
+
+    audioch_t m_channels = 0;
+    unsigned int m_L = 1; //!< up factor
+    unsigned int m_M = 1; //!< down factor
+    unsigned int m_phases = 1;
+
+    //! m_phases rows of TAPS_PER_PHASE coefficients, each row reversed so it runs along the history
+    std::vector<float> m_bank;
+
+    //! per channel: TAPS_PER_PHASE - 1 frames of history followed by up to m_blockSize new frames
+    std::vector<std::vector<float> > m_history;
+    samples_t m_blockSize = 0;
+    samples_t m_filled = 0; //!< new frames in the history buffers
+    samples_t m_index = 0;  //!< newest input frame of the next output, relative to the new frames
+    unsigned int m_phase = 0;
+};
+}
+
+#endif // MU_AUDIO_POLYPHASERESAMPLER_H
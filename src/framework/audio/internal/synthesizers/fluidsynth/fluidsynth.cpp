@@ -252,6 +252,8 @@ void FluidSynth::setupSound(const PlaybackSetupData& setupData)
         return;
     }
 
+    prefetchSamples(setupData);
+
     fluid_synth_activate_key_tuning(m_fluid->synth, 0, 0, "standard", NULL, true);
 
     auto setupChannel = [this](const midi::channel_t channelIdx, const midi::Program& program) {
@@ -277,6 +279,26 @@ void FluidSynth::setupSound(const PlaybackSetupData& setupData)
     }
 }
 
+void FluidSynth::prefetchSamples(const PlaybackSetupData& setupData)
+{
+    //! NOTE Channels are created and their presets selected while the events are being loaded,
+    //!      let the samples of all programs the track may use be loaded in the background meanwhile
+    midi::Programs programs = findPrograms(setupData);
+    for (const auto& pair : articulationSounds(setupData)) {
+        programs.push_back(pair.second);
+    }
+
+    std::vector<SoundFontPrefetcher::SamplesPtr> prefetched;
+
+    int sfontCount = fluid_synth_sfcount(m_fluid->synth);
+    for (int i = 0; i < sfontCount; ++i) {
+        fluid_sfont_t* sfont = fluid_synth_get_sfont(m_fluid->synth, i);
+        prefetched.push_back(SoundFontPrefetcher::instance()->prefetch(sfont, programs));
+    }
+
+    m_prefetchedSamples = std::move(prefetched);
+}
+
 void FluidSynth::setupEvents(const mpe::PlaybackData& playbackData)
 {
     m_sequencer.load(playbackData);
@@ -36,6 +36,7 @@
 #include "../../abstractsynthesizer.h"
 #include "fluidsequencer.h"
 #include "soundmapping.h"
+#include "soundfontprefetcher.h"
 
 namespace mu::audio::synth {
 struct Fluid;
@@ -99,6 +100,7 @@ private:
 
     Ret init();
     void createFluidInstance();
+    void prefetchSamples(const mpe::PlaybackSetupData& setupData);
 
     bool handleEvent(const midi::Event& event);
 
@@ -113,6 +115,7 @@ private:
 
     FluidSequencer m_sequencer;
     std::set<io::path_t> m_sfontPaths;
+    std::vector<SoundFontPrefetcher::SamplesPtr> m_prefetchedSamples;
 
     KeyTuning m_tuning;
 };
@@ -23,6 +23,8 @@
 #ifndef MU_AUDIO_SFCACHEDLOADER_H
 #define MU_AUDIO_SFCACHEDLOADER_H
 
+#include "soundfontfilestore.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -41,7 +43,6 @@ namespace mu::audio::synth {
 struct SoundFontData
 {
     fluid_sfont_t* soundFontPtr = nullptr;
-    std::FILE* fileStream = nullptr;
 };
 
 struct SoundFontCache : public std::map<std::string, SoundFontData> {
@@ -63,55 +64,44 @@ private:
             }
 
             delete_fluid_sfont(pair.second.soundFontPtr);
-
-            if (pair.second.fileStream) {
-                std::fclose(pair.second.fileStream);
-            }
         }
     }
 };
 
+//!Note Every open gets its own read position over the shared mapping of the file,
+//!     so synth instances loading samples at the same time don't move each other's position
+
 void* openSoundFont(const char* filename)
 {
-    auto search = SoundFontCache::instance()->find(filename);
-
-    if (search != SoundFontCache::instance()->cend()
-        && search->second.fileStream) {
-        return search->second.fileStream;
-    }
-
-    std::FILE* stream = std::fopen(filename, "r");
-
-    SoundFontData sfData;
-    sfData.fileStream = stream;
-
-    SoundFontCache::instance()->emplace(filename, std::move(sfData));
-
-    return stream;
+    return SoundFontFileStore::instance()->open(filename);
 }
 
 int readSoundFont(void* buf, int count, void* handle)
 {
-    return static_cast<int>(std::fread(buf, count, 1, static_cast<std::FILE*>(handle)));
+    if (count < 0) {
+        return FLUID_FAILED;
+    }
+
+    bool ok = SoundFontFileStore::read(static_cast<SoundFontFileStore::Cursor*>(handle), buf, static_cast<size_t>(count));
+    return ok ? FLUID_OK : FLUID_FAILED;
 }
 
 int seekSoundFont(void* handle, long offset, int origin)
 {
-    return std::fseek(static_cast<std::FILE*>(handle), offset, origin);
+    bool ok = SoundFontFileStore::seek(static_cast<SoundFontFileStore::Cursor*>(handle), offset, origin);
+    return ok ? FLUID_OK : FLUID_FAILED;
 }
 
-int closeSoundFont(void* /*handle*/)
+int closeSoundFont(void* handle)
 {
-    //!Note Prevent closing of sound-font files by Fluid instances,
-    //!     instead the actual closing of cached sound-font files will happen in SoundFontCache.
-    //!     However, we still need to provide "some" callback for Fluid's API
+    SoundFontFileStore::instance()->close(static_cast<SoundFontFileStore::Cursor*>(handle));
 
     return FLUID_OK;
 }
 
 long tellSoundFont(void* handle)
 {
-    return std::ftell(static_cast<std::FILE*>(handle));
+    return SoundFontFileStore::tell(static_cast<SoundFontFileStore::Cursor*>(handle));
 }
 
 int deleteSoundFont(fluid_sfont_t* /*sfont*/)
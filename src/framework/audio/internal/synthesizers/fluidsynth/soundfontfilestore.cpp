@@ -0,0 +1,364 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "soundfontfilestore.h"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "log.h"
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#if !defined(Q_OS_WASM)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#endif
+
+using namespace mu::audio::synth;
+
+namespace {
+//! NOTE Identifies the file a mapping was made of. A file replaced or truncated on disk
+//!      must not be read through the old mapping, pages past the new end of file raise SIGBUS
+struct FileStamp
+{
+    uint64_t size = 0;
+    int64_t modified = 0;
+    uint64_t id = 0;
+
+    bool operator==(const FileStamp& other) const
+    {
+        return size == other.size && modified == other.modified && id == other.id;
+    }
+
+    bool operator!=(const FileStamp& other) const { return !operator==(other); }
+};
+}
+
+#if defined(Q_OS_WIN)
+
+static std::wstring toWide(const std::string& path)
+{
+    int len = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring wpath(static_cast<size_t>(len), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, wpath.data(), len);
+    return wpath;
+}
+
+static int64_t toInt64(const FILETIME& time)
+{
+    return static_cast<int64_t>((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime);
+}
+
+static bool readFileStamp(const std::string& path, FileStamp& stamp)
+{
+    WIN32_FILE_ATTRIBUTE_DATA attrs;
+    if (!GetFileAttributesExW(toWide(path).c_str(), GetFileExInfoStandard, &attrs)) {
+        return false;
+    }
+
+    stamp.size = (static_cast<uint64_t>(attrs.nFileSizeHigh) << 32) | attrs.nFileSizeLow;
+    stamp.modified = toInt64(attrs.ftLastWriteTime);
+    stamp.id = 0;
+    return true;
+}
+
+#else
+
+static FileStamp toFileStamp(const struct stat& st)
+{
+    FileStamp stamp;
+    stamp.size = static_cast<uint64_t>(st.st_size);
+    stamp.modified = static_cast<int64_t>(st.st_mtime);
+    stamp.id = static_cast<uint64_t>(st.st_ino);
+    return stamp;
+}
+
+static bool readFileStamp(const std::string& path, FileStamp& stamp)
+{
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || st.st_size < 0) {
+        return false;
+    }
+
+    stamp = toFileStamp(st);
+    return true;
+}
+
+#endif
+
+//! NOTE The file size is checked against the address space before mapping
+static bool isMappableSize(uint64_t size)
+{
+    return size > 0 && size <= static_cast<uint64_t>(std::numeric_limits<size_t>::max());
+}
+
+struct SoundFontFileStore::MappedFile
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    FileStamp stamp;
+
+#if defined(Q_OS_WIN)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#elif defined(Q_OS_WASM)
+    std::vector<uint8_t> buffer;
+#endif
+
+    ~MappedFile() { unmap(); }
+
+    bool map(const std::string& path);
+    void unmap();
+};
+
+#if defined(Q_OS_WIN)
+
+bool SoundFontFileStore::MappedFile::map(const std::string& path)
+{
+    file = CreateFileW(toWide(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    FILETIME modified;
+    if (!GetFileSizeEx(file, &fileSize) || !GetFileTime(file, nullptr, nullptr, &modified)
+        || !isMappableSize(static_cast<uint64_t>(fileSize.QuadPart))) {
+        unmap();
+        return false;
+    }
+
+    stamp.size = static_cast<uint64_t>(fileSize.QuadPart);
+    stamp.modified = toInt64(modified);
+    stamp.id = 0;
+
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        unmap();
+        return false;
+    }
+
+    data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data) {
+        unmap();
+        return false;
+    }
+
+    size = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void SoundFontFileStore::MappedFile::unmap()
+{
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+
+    if (mapping) {
+        CloseHandle(mapping);
+    }
+
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+    }
+
+    data = nullptr;
+    size = 0;
+    mapping = nullptr;
+    file = INVALID_HANDLE_VALUE;
+}
+
+#elif defined(Q_OS_WASM)
+
+//! NOTE No shared mappings here, just keep one copy of the file for all instances
+bool SoundFontFileStore::MappedFile::map(const std::string& path)
+{
+    if (!readFileStamp(path, stamp) || !isMappableSize(stamp.size)) {
+        return false;
+    }
+
+    std::FILE* stream = std::fopen(path.c_str(), "rb");
+    if (!stream) {
+        return false;
+    }
+
+    std::fseek(stream, 0, SEEK_END);
+    long fileSize = std::ftell(stream);
+    std::fseek(stream, 0, SEEK_SET);
+
+    if (fileSize > 0) {
+        buffer.resize(static_cast<size_t>(fileSize));
+        if (std::fread(buffer.data(), buffer.size(), 1, stream) != 1) {
+            buffer.clear();
+        }
+    }
+
+    std::fclose(stream);
+
+    data = buffer.data();
+    size = buffer.size();
+    return size > 0;
+}
+
+void SoundFontFileStore::MappedFile::unmap()
+{
+    buffer.clear();
+    buffer.shrink_to_fit();
+    data = nullptr;
+    size = 0;
+}
+
+#else
+
+bool SoundFontFileStore::MappedFile::map(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < 0 || !isMappableSize(static_cast<uint64_t>(st.st_size))) {
+        ::close(fd);
+        return false;
+    }
+
+    stamp = toFileStamp(st);
+
+    void* addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+
+    //! NOTE The mapping stays valid after the descriptor is closed
+    ::close(fd);
+
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+
+    data = static_cast<const uint8_t*>(addr);
+    size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void SoundFontFileStore::MappedFile::unmap()
+{
+    if (data) {
+        ::munmap(const_cast<uint8_t*>(data), size);
+    }
+
+    data = nullptr;
+    size = 0;
+}
+
+#endif
+
+SoundFontFileStore* SoundFontFileStore::instance()
+{
+    static SoundFontFileStore s;
+    return &s;
+}
+
+SoundFontFileStore::Cursor* SoundFontFileStore::open(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    FileStamp stamp;
+    if (!readFileStamp(path, stamp)) {
+        LOGE() << "failed to stat sound font file: " << path;
+        return nullptr;
+    }
+
+    std::shared_ptr<MappedFile> file = m_files[path].lock();
+
+    //! NOTE A file changed on disk gets a new mapping,
+    //!      cursors still open over the old one keep it alive until they are closed
+    if (!file || file->stamp != stamp) {
+        file = std::make_shared<MappedFile>();
+        if (!file->map(path)) {
+            LOGE() << "failed to map sound font file: " << path;
+            m_files.erase(path);
+            return nullptr;
+        }
+
+        m_files[path] = file;
+    }
+
+    Cursor* cursor = new Cursor();
+    cursor->data = file->data;
+    cursor->size = file->size;
+    cursor->file = std::move(file);
+    return cursor;
+}
+
+void SoundFontFileStore::close(Cursor* cursor)
+{
+    //! NOTE The mapping is released with its last cursor
+    delete cursor;
+}
+
+bool SoundFontFileStore::read(Cursor* cursor, void* buf, size_t count)
+{
+    if (!cursor || count > cursor->size - cursor->pos) {
+        return false;
+    }
+
+    std::memcpy(buf, cursor->data + cursor->pos, count);
+    cursor->pos += count;
+    return true;
+}
+
+bool SoundFontFileStore::seek(Cursor* cursor, long offset, int origin)
+{
+    if (!cursor) {
+        return false;
+    }
+
+    long long base = 0;
+    switch (origin) {
+    case SEEK_SET: base = 0;
+        break;
+    case SEEK_CUR: base = static_cast<long long>(cursor->pos);
+        break;
+    case SEEK_END: base = static_cast<long long>(cursor->size);
+        break;
+    default:
+        return false;
+    }
+
+    long long pos = base + offset;
+    if (pos < 0 || pos > static_cast<long long>(cursor->size)) {
+        return false;
+    }
+
+    cursor->pos = static_cast<size_t>(pos);
+    return true;
+}
+
+long SoundFontFileStore::tell(const Cursor* cursor)
+{
+    return cursor ? static_cast<long>(cursor->pos) : -1;
+}
@@ -0,0 +1,69 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_SOUNDFONTFILESTORE_H
+#define MU_AUDIO_SOUNDFONTFILESTORE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace mu::audio::synth {
+//! NOTE Read-only, memory-mapped sound font files shared by all FluidSynth instances of the process.
+//!      Fluid reads the headers on load and then, with dynamic sample loading, only the samples
+//!      of the presets selected on a channel. Mapping the file means those reads are plain memory copies
+//!      from the page cache, there's no FILE* position to share between synth instances,
+//!      and untouched parts of multi-GB banks never become resident.
+//!      A mapping lives as long as there are open cursors over it.
+class SoundFontFileStore
+{
+    struct MappedFile;
+
+public:
+    static SoundFontFileStore* instance();
+
+    struct Cursor {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t pos = 0;
+
+        std::shared_ptr<MappedFile> file;
+    };
+
+    Cursor* open(const std::string& path);
+    void close(Cursor* cursor);
+
+    static bool read(Cursor* cursor, void* buf, size_t count);
+    static bool seek(Cursor* cursor, long offset, int origin);
+    static long tell(const Cursor* cursor);
+
+private:
+    SoundFontFileStore() = default;
+
+    std::mutex m_mutex;
+    std::map<std::string, std::weak_ptr<MappedFile> > m_files;
+};
+}
+
+#endif // MU_AUDIO_SOUNDFONTFILESTORE_H
@@ -0,0 +1,267 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "soundfontprefetcher.h"
+
+#include <atomic>
+
+#include "log.h"
+
+using namespace mu::audio::synth;
+
+//! NOTE Samples may outlive the prefetcher at exit
+static std::atomic<bool> s_prefetcherDestroyed { false };
+
+//! NOTE Every distinct program being prefetched occupies one channel of the holder synth
+static constexpr int HOLDER_CHANNELS = 256;
+
+SoundFontPrefetcher* SoundFontPrefetcher::instance()
+{
+    static SoundFontPrefetcher s;
+    return &s;
+}
+
+SoundFontPrefetcher::~SoundFontPrefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = true;
+        m_jobs.clear();
+    }
+
+    m_cond.notify_all();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    s_prefetcherDestroyed = true;
+}
+
+SoundFontPrefetcher::Samples::~Samples()
+{
+    if (m_channels.empty() || s_prefetcherDestroyed) {
+        return;
+    }
+
+    //! NOTE Unselecting the programs may free samples, leave that to the prefetch thread too
+    Job job;
+    job.releasedChannels = std::move(m_channels);
+    SoundFontPrefetcher::instance()->push(std::move(job));
+}
+
+SoundFontPrefetcher::SamplesPtr SoundFontPrefetcher::prefetch(fluid_sfont_t* sfont, const midi::Programs& programs)
+{
+    SamplesPtr samples = std::make_shared<Samples>();
+
+    if (!sfont || programs.empty()) {
+        return samples;
+    }
+
+#ifdef Q_OS_WASM
+    //! NOTE No background threads here, the samples get loaded on preset selection
+    return samples;
+#endif
+
+    const char* path = fluid_sfont_get_name(sfont);
+    if (!path) {
+        return samples;
+    }
+
+    push({ path, programs, samples, {} });
+
+    return samples;
+}
+
+void SoundFontPrefetcher::push(Job&& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopped) {
+            return;
+        }
+
+        ensureThread();
+        m_jobs.push_back(std::move(job));
+    }
+
+    m_cond.notify_one();
+}
+
+void SoundFontPrefetcher::ensureThread()
+{
+    if (!m_thread.joinable()) {
+        m_thread = std::thread([this]() { run(); });
+    }
+}
+
+void SoundFontPrefetcher::run()
+{
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this]() { return m_stopped || !m_jobs.empty(); });
+
+            if (m_stopped) {
+                break;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        if (!job.releasedChannels.empty()) {
+            release(job.releasedChannels);
+            continue;
+        }
+
+        //! NOTE The synth is already gone, nobody is waiting for these samples
+        if (job.samples.use_count() == 1) {
+            continue;
+        }
+
+        load(job);
+    }
+
+    deleteHolder();
+}
+
+bool SoundFontPrefetcher::ensureHolder()
+{
+    if (m_holder) {
+        return true;
+    }
+
+    m_holderSettings = new_fluid_settings();
+    fluid_settings_setint(m_holderSettings, "synth.dynamic-sample-loading", 1);
+    fluid_settings_setint(m_holderSettings, "synth.lock-memory", 0);
+    fluid_settings_setint(m_holderSettings, "synth.threadsafe-api", 0);
+    fluid_settings_setint(m_holderSettings, "synth.midi-channels", HOLDER_CHANNELS);
+    fluid_settings_setint(m_holderSettings, "synth.polyphony", 1);
+    fluid_settings_setint(m_holderSettings, "synth.chorus.active", 0);
+    fluid_settings_setint(m_holderSettings, "synth.reverb.active", 0);
+
+    m_holder = new_fluid_synth(m_holderSettings);
+    if (!m_holder) {
+        LOGE() << "failed to create the prefetch synth";
+        delete_fluid_settings(m_holderSettings);
+        m_holderSettings = nullptr;
+        return false;
+    }
+
+    m_channelPrograms.assign(HOLDER_CHANNELS, ProgramKey());
+    m_channelRefs.assign(HOLDER_CHANNELS, 0);
+    m_freeChannels.clear();
+    for (int channel = HOLDER_CHANNELS - 1; channel >= 0; --channel) {
+        m_freeChannels.push_back(channel);
+    }
+
+    return true;
+}
+
+void SoundFontPrefetcher::deleteHolder()
+{
+    //! NOTE Deleting the synth unselects all programs and unloads its copies of the sound fonts
+    if (m_holder) {
+        delete_fluid_synth(m_holder);
+        m_holder = nullptr;
+    }
+
+    if (m_holderSettings) {
+        delete_fluid_settings(m_holderSettings);
+        m_holderSettings = nullptr;
+    }
+
+    m_holderSoundFontIds.clear();
+    m_channelByProgram.clear();
+}
+
+void SoundFontPrefetcher::load(const Job& job)
+{
+    TRACEFUNC;
+
+    if (!ensureHolder()) {
+        return;
+    }
+
+    auto idIt = m_holderSoundFontIds.find(job.sfontPath);
+    if (idIt == m_holderSoundFontIds.end()) {
+        int sfontId = fluid_synth_sfload(m_holder, job.sfontPath.c_str(), 0);
+        if (sfontId == FLUID_FAILED) {
+            LOGE() << "failed to load sound font into the prefetch synth: " << job.sfontPath;
+            m_holderSoundFontIds.emplace(job.sfontPath, FLUID_FAILED);
+            return;
+        }
+
+        idIt = m_holderSoundFontIds.emplace(job.sfontPath, sfontId).first;
+    }
+
+    if (idIt->second == FLUID_FAILED) {
+        return;
+    }
+
+    for (const midi::Program& program : job.programs) {
+        ProgramKey key { job.sfontPath, program.bank, program.program };
+
+        int channel = -1;
+        auto it = m_channelByProgram.find(key);
+        if (it != m_channelByProgram.end()) {
+            channel = it->second;
+        } else {
+            //! NOTE When all channels are taken the samples just get loaded on selection
+            if (m_freeChannels.empty()) {
+                continue;
+            }
+
+            channel = m_freeChannels.back();
+
+            //! NOTE Selecting the preset is what makes Fluid load its samples
+            if (fluid_synth_program_select(m_holder, channel, idIt->second, program.bank, program.program) != FLUID_OK) {
+                continue;
+            }
+
+            m_freeChannels.pop_back();
+            m_channelByProgram.emplace(key, channel);
+            m_channelPrograms[channel] = key;
+        }
+
+        ++m_channelRefs[channel];
+        job.samples->m_channels.push_back(channel);
+    }
+}
+
+void SoundFontPrefetcher::release(const std::vector<int>& channels)
+{
+    if (!m_holder) {
+        return;
+    }
+
+    for (int channel : channels) {
+        if (--m_channelRefs[channel] > 0) {
+            continue;
+        }
+
+        fluid_synth_unset_program(m_holder, channel);
+        m_channelByProgram.erase(m_channelPrograms[channel]);
+        m_freeChannels.push_back(channel);
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_SOUNDFONTPREFETCHER_H
+#define MU_AUDIO_SOUNDFONTPREFETCHER_H
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <fluidsynth.h>
+
+#include "midi/miditypes.h"
+
+namespace mu::audio::synth {
+//! NOTE With dynamic sample loading Fluid reads (and for SF3 decodes) the samples of a preset
+//!      when the preset gets selected on a channel, i.e. on the audio worker thread.
+//!      The prefetcher selects the programs a track is going to use on the channels of its own
+//!      holder synth on a background thread. That loads their samples into Fluid's process-wide
+//!      sample cache, so the later selection on the worker only takes a reference.
+//!      Only the public Fluid API is used, Fluid itself decides what and how to load.
+//!      The holder loads its own copy of every sound font, Fluid's sound font objects
+//!      are not safe to select presets of from several threads.
+class SoundFontPrefetcher
+{
+public:
+    static SoundFontPrefetcher* instance();
+
+    //! NOTE Keeps the prefetched programs selected on the holder synth until destroyed
+    class Samples
+    {
+    public:
+        ~Samples();
+
+    private:
+        friend class SoundFontPrefetcher;
+
+        std::vector<int> m_channels;
+    };
+
+    using SamplesPtr = std::shared_ptr<Samples>;
+
+    SamplesPtr prefetch(fluid_sfont_t* sfont, const midi::Programs& programs);
+
+private:
+    SoundFontPrefetcher() = default;
+    ~SoundFontPrefetcher();
+
+    struct Job {
+        std::string sfontPath;
+        midi::Programs programs;
+        SamplesPtr samples;
+        std::vector<int> releasedChannels;
+    };
+
+    using ProgramKey = std::tuple<std::string, int /*bank*/, int /*program*/>;
+
+    void push(Job&& job);
+    void ensureThread();
+    void run();
+
+    bool ensureHolder();
+    void deleteHolder();
+    void load(const Job& job);
+    void release(const std::vector<int>& channels);
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::deque<Job> m_jobs;
+    std::thread m_thread;
+    bool m_stopped = false;
+
+    //! NOTE Used on the prefetch thread only
+    fluid_settings_t* m_holderSettings = nullptr;
+    fluid_synth_t* m_holder = nullptr;
+    std::map<std::string, int> m_holderSoundFontIds;
+    std::map<ProgramKey, int> m_channelByProgram;
+    std::vector<ProgramKey> m_channelPrograms;
+    std::vector<int> m_channelRefs;
+    std::vector<int> m_freeChannels;
+};
+}
+
+#endif // MU_AUDIO_SOUNDFONTPREFETCHER_H
@@ -20,74 +20,94 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "samplerateconvertor.h"
+
+#include <algorithm>
+
 #include "log.h"
-#include <cmath>
 
 using namespace mu::audio;
+using namespace mu::audio::dsp;
+
+static constexpr samples_t BLOCK_FRAMES = 1024;
 
 SampleRateConvertor::SampleRateConvertor(const std::vector<float>& data,
                                          unsigned int channelsCount,
                                          unsigned int sampleRateIn,
                                          unsigned int sampleRateOut)
-    : m_data(data), m_fir(), m_channelsCount(channelsCount), m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut)
+    : m_data(data), m_channelsCount(channelsCount), m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut)
 {
-    m_fir.resize(FIR_LENGTH, 0);
-    m_y.resize(FIR_LENGTH, 0);
-    initWindow();
 }
 
 std::vector<float> SampleRateConvertor::convert()
 {
     std::vector<float> out;
-    auto resultSamples = m_data.size() * m_sampleRateOut / (m_channelsCount * m_sampleRateIn);
-
-    out.resize(resultSamples * m_channelsCount);
-    for (unsigned sample = 0; sample < resultSamples; ++sample) {
-        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
-            out[sample * m_channelsCount + channel] = y(sample, channel);
-        }
+    if (!ensureResampler()) {
+        return out;
     }
 
+    samples_t resultFrames = outputFramesCount();
+    out.resize(resultFrames * m_channelsCount);
+
+    seek(0);
+    unsigned int converted = convert(out.data(), 0, static_cast<unsigned int>(resultFrames));
+    out.resize(converted * m_channelsCount);
+
     return out;
 }
 
 unsigned int SampleRateConvertor::convert(float* buffer, unsigned int from, unsigned int count)
 {
-    unsigned int sample = from;
+    if (!ensureResampler()) {
+        return 0;
+    }
+
+    if (!m_positioned || from != m_nextOutputFrame) {
+        seek(from);
+    }
+
+    const samples_t inputFrames = inputFramesCount();
+    const samples_t outputFrames = outputFramesCount();
     unsigned int converted = 0;
 
-    for (converted = 0; converted < count; ++converted, ++sample) {
-        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
-            if (!availableSamples(sample)) {
-                return converted;
-            }
-            buffer[converted * m_channelsCount + channel] = y(sample, channel);
+    while (converted < count && m_nextOutputFrame < outputFrames) {
+        samples_t wanted = std::min<samples_t>(count - converted, outputFrames - m_nextOutputFrame);
+
+        //! past the end of the data the filter is flushed with silence
+        const float* input = m_silence.data();
+        samples_t available = BLOCK_FRAMES;
+        if (m_inputFrame < inputFrames) {
+            input = m_data.data() + m_inputFrame * m_channelsCount;
+            available = inputFrames - m_inputFrame;
         }
-    }
-    return converted;
-}
 
-float SampleRateConvertor::y(unsigned int sample, unsigned int channel) const
-{
-    switch (m_method) {
-    case SINC:
-        return ySinc(sample, channel);
-    case FIR:
-        return yFIR(sample, channel);
+        samples_t consumed = 0;
+        samples_t produced = m_resampler->process(input, available, consumed, buffer + converted * m_channelsCount, wanted);
+
+        m_inputFrame += consumed;
+        m_nextOutputFrame += produced;
+        converted += static_cast<unsigned int>(produced);
+
+        if (produced == 0 && consumed == 0) {
+            break;
+        }
     }
-    return 0.f;
+
+    return converted;
 }
 
 void SampleRateConvertor::setChannelCount(unsigned int count)
 {
-    m_channelsCount = count;
+    if (m_channelsCount != count) {
+        m_channelsCount = count;
+        m_resampler.reset();
+    }
 }
 
 void SampleRateConvertor::setSampleRateIn(unsigned int sampleRate)
 {
     if (m_sampleRateIn != sampleRate) {
         m_sampleRateIn = sampleRate;
-        initWindow();
+        m_resampler.reset();
     }
 }
 
@@ -95,116 +115,58 @@ void SampleRateConvertor::setSampleRateOut(unsigned int sampleRate)
 {
     if (m_sampleRateOut != sampleRate) {
         m_sampleRateOut = sampleRate;
-        initWindow();
+        m_resampler.reset();
     }
 }
 
-float SampleRateConvertor::ySinc(unsigned int sample, unsigned int channel) const
+bool SampleRateConvertor::ensureResampler()
 {
-    double currentOutputSampleTime = sample / static_cast<double>(m_sampleRateOut);
-    auto zeroInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn);
-
-    float out = 0.f;
-    for (unsigned int i = 0; i < USE_SAMPLES; ++i) {
-        int currentSample = zeroInputSample + i - USE_SAMPLES / 2;
-        double currentInputSampleTime = currentSample / static_cast<double>(m_sampleRateIn);
-
-        if (currentSample < 0 || currentSample * m_channelsCount + channel >= m_data.size()) {
-            continue;
-        }
-        out += m_data.at(currentSample * m_channelsCount + channel) * sinc(currentOutputSampleTime - currentInputSampleTime);
+    if (m_resampler) {
+        return true;
     }
-    return out;
-}
 
-float SampleRateConvertor::yFIR(unsigned int sample, unsigned int channel) const
-{
-    auto x = [this, &channel](int m) -> float {
-        int pos = m * m_M / m_L * m_channelsCount + channel;
-        if (pos >= 0 && pos < static_cast<int>(m_data.size())) {
-            return m_data.at(pos);
-        }
-        return 0.f;
-    };
-
-    float y = 0.f;
-    for (unsigned int i = 0; i < FIR_LENGTH; ++i) {
-        int t = sample - static_cast<int>(i);
-        y += x(t) * m_fir[i];
+    if (m_channelsCount == 0 || m_sampleRateIn == 0 || m_sampleRateOut == 0) {
+        return false;
     }
-    return y;
-}
 
-bool SampleRateConvertor::availableSamples(unsigned int sample) const
-{
-    float currentOutputSampleTime = sample / static_cast<float>(m_sampleRateOut);
-    auto firstInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn) - USE_SAMPLES / 2;
+    m_resampler = std::make_unique<PolyphaseResampler>(static_cast<audioch_t>(m_channelsCount), m_sampleRateIn, m_sampleRateOut,
+                                                       BLOCK_FRAMES);
+    m_seekHistory.assign((PolyphaseResampler::TAPS_PER_PHASE - 1) * m_channelsCount, 0.f);
+    m_silence.assign(BLOCK_FRAMES * m_channelsCount, 0.f);
+    m_positioned = false;
 
-    // first sample for conversion points out of the input buffer
-    if (firstInputSample * m_channelsCount >= m_data.size()) {
-        return false;
-    }
     return true;
 }
 
-inline double zeroBessel(double x)
+void SampleRateConvertor::seek(unsigned int outputFrame)
 {
-    //return std::cyl_bessel_i(0, x);
-
-    double s = 1, y = 1;
-    int m = 1;
-
-    while (y > std::numeric_limits<float>::min()) {
-        m += 2;
-        y *= x * x / (4 * m * m);
-        s += s * y;
+    //! output frame n lies at input position n * M / L, the filter needs delay() frames ahead of it
+    const uint64_t position = static_cast<uint64_t>(outputFrame) * m_resampler->downFactor();
+    const unsigned int phase = static_cast<unsigned int>(position % m_resampler->upFactor());
+    const samples_t firstInput = position / m_resampler->upFactor() + PolyphaseResampler::delay();
+
+    const samples_t inputFrames = inputFramesCount();
+    const samples_t historyFrames = PolyphaseResampler::TAPS_PER_PHASE - 1;
+    for (samples_t s = 0; s < historyFrames; ++s) {
+        int64_t frame = static_cast<int64_t>(firstInput) - static_cast<int64_t>(historyFrames) + static_cast<int64_t>(s);
+        for (unsigned int c = 0; c < m_channelsCount; ++c) {
+            bool inside = frame >= 0 && static_cast<samples_t>(frame) < inputFrames;
+            m_seekHistory[s * m_channelsCount + c] = inside ? m_data[frame * m_channelsCount + c] : 0.f;
+        }
     }
 
-    return s;
+    m_resampler->reset(phase, m_seekHistory.data());
+    m_inputFrame = firstInput;
+    m_nextOutputFrame = outputFrame;
+    m_positioned = true;
 }
 
-void SampleRateConvertor::initWindow()
+samples_t SampleRateConvertor::inputFramesCount() const
 {
-    int max = std::max(m_sampleRateIn, m_sampleRateOut), min = std::min(m_sampleRateIn, m_sampleRateOut);
-    int maxCommonDivider = 1;
-    while (max % min != 0) {
-        maxCommonDivider = max % min;
-        max = min;
-        min = maxCommonDivider;
-    }
-    m_M = m_sampleRateIn / maxCommonDivider;
-    m_L = m_sampleRateOut / maxCommonDivider;
-    double fStop = std::min(m_sampleRateIn, m_sampleRateOut) / 2,
-           fIntermediateSampleRate = m_sampleRateIn * m_M,
-           attenuation = 96 /*dB*/;
-    int M = FIR_LENGTH;
-    int Np = (M - 1) / 2;
-
-    double alpha = 0.1102 * (attenuation - 8.7);
-    double A[FIR_LENGTH];
-
-    A[0] = 2 * fStop / fIntermediateSampleRate;
-    for (int j = 1; j <= Np; j++) {
-        A[j]  = std::sin(2 * j * M_PI * fStop / fIntermediateSampleRate) / j * M_PI;
-    }
-
-    for (int j = 0; j <= Np; j++) {
-        m_fir[Np + j]  = A[j];
-        m_fir[Np + j] *= zeroBessel(alpha * std::sqrt(1 - (j * j / (Np * Np))));
-        m_fir[Np + j] /= zeroBessel(alpha);
-    }
-
-    for (int j = 0; j < Np; j++) {
-        m_fir[j] = m_fir[M - 1 - j];
-    }
+    return m_channelsCount ? m_data.size() / m_channelsCount : 0;
 }
 
-double SampleRateConvertor::sinc(double value) const
+samples_t SampleRateConvertor::outputFramesCount() const
 {
-    if (value == 0) {
-        return 1.f;
-    }
-    double sincArg = M_PI * value * m_sampleRateIn;
-    double gain = std::min(1.0, m_sampleRateOut / static_cast<double>(m_sampleRateIn));
-    return gain * std::sin(sincArg) / sincArg;
+    return inputFramesCount() * m_sampleRateOut / m_sampleRateIn;
 }
@@ -22,15 +22,15 @@
 #ifndef MU_AUDIO_SAMPLERATECONVERTOR_H
 #define MU_AUDIO_SAMPLERATECONVERTOR_H
 
+#include <memory>
 #include <vector>
-#include <deque>
+
+#include "internal/dsp/polyphaseresampler.h"
+
 namespace mu::audio {
 class SampleRateConvertor
 {
 public:
-    enum Method {
-        SINC, FIR
-    };
     explicit SampleRateConvertor(const std::vector<float>& data, unsigned int channelsCount, unsigned int sampleRateIn,
                                  unsigned int sampleRateOut);
 
@@ -38,6 +38,8 @@ public:
     std::vector<float> convert();
 
     //! online convert
+    //! NOTE: consecutive calls (from == previous from + previous result) continue the filter state,
+    //! any other position restarts it from the input around that position
     unsigned int convert(float* buffer, unsigned int from, unsigned int count);
 
     void setChannelCount(unsigned int count);
@@ -45,34 +47,23 @@ public:
     void setSampleRateOut(unsigned int sampleRate);
 
 private:
+    bool ensureResampler();
+    void seek(unsigned int outputFrame);
+    samples_t inputFramesCount() const;
+    samples_t outputFramesCount() const;
 
-    //! return value of sinc function (LPF) with consideration of used sampleRates
-    double sinc(double value) const;
-
-    //! output sample value
-    float y(unsigned int sample, unsigned int channel) const;
-    float ySinc(unsigned int sample, unsigned int channel) const;
-    float yFIR(unsigned int sample, unsigned int channel) const;
-
-    //! return true if there are samples in input buffer for conversion
-    bool availableSamples(unsigned int sample) const;
-
-    //! calculate window function values
-    void initWindow();
-
-    const static unsigned int USE_SAMPLES = 16; //!< this value defines the quality and complexity of SRC.
     const std::vector<float>& m_data;
 
-    //! values of window function for USE_SAMPLES
-    const static unsigned int FIR_LENGTH = 33;
-    unsigned int m_M = 1, m_L = 1;
-    std::vector<float> m_fir;
-    mutable std::deque<float> m_y;
-
     unsigned int m_channelsCount;
     unsigned int m_sampleRateIn;
     unsigned int m_sampleRateOut;
-    Method m_method = FIR;
+
+    std::unique_ptr<dsp::PolyphaseResampler> m_resampler;
+    std::vector<float> m_seekHistory;
+    std::vector<float> m_silence;
+    samples_t m_inputFrame = 0;      //!< next input frame to feed, may point past the end of the data (silence)
+    samples_t m_nextOutputFrame = 0;
+    bool m_positioned = false;
 };
 }
 
@@ -25,6 +25,7 @@
 
 #include "modularity/imoduleexport.h"
 
+#include "async/notification.h"
 #include "io/path.h"
 #include "types/string.h"
 #include "types/font.h"
@@ -42,6 +43,9 @@ public:
     virtual int addTextFont(const io::path_t& path) = 0;
     virtual void insertSubstitution(const String& familyName, const String& substituteName) = 0;
 
+    //! NOTE Sent when fonts were registered or substituted, the metrics of known fonts may change then
+    virtual async::Notification fontsChanged() const = 0;
+
     virtual double lineSpacing(const Font& f) const = 0;
     virtual double xHeight(const Font& f) const = 0;
     virtual double height(const Font& f) const = 0;
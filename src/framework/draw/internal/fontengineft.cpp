@@ -21,7 +21,8 @@
  */
 #include "fontengineft.h"
 
-#include <QHash>
+#include <mutex>
+#include <unordered_map>
 
 #include "io/file.h"
 
@@ -49,17 +50,23 @@ static bool _init_ft()
     return error == 0;
 }
 
-struct mu::draw::FTGlyphMetrics
+//! NOTE Everything we need from FreeType about one glyph, loaded once per engine.
+//! Missing glyphs are cached as well, they are asked for on every symbol fallback lookup
+struct mu::draw::FTGlyph
 {
+    bool valid = false;
     FT_BBox bb;
     double linearHoriAdvance = 0.0;
 };
 
+//! NOTE The face and its glyph slot are shared by all callers of the engine,
+//! so the glyph cache and every FreeType call on the face are guarded by the mutex
 struct mu::draw::FTData
 {
     ByteArray fontData;
     FT_Face face = nullptr;
-    QHash<char32_t, FTGlyphMetrics> metrics;
+    std::unordered_map<char32_t, FTGlyph> glyphs;
+    std::mutex mutex;
 };
 
 FontEngineFT::FontEngineFT()
@@ -101,12 +108,13 @@ bool FontEngineFT::load(const io::path_t& path)
 
 QRectF FontEngineFT::bbox(char32_t ucs4, double dpi_f) const
 {
-    FTGlyphMetrics* gm = glyphMetrics(ucs4);
-    if (!gm) {
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+    const FTGlyph* g = glyph(ucs4);
+    if (!g) {
         return QRectF();
     }
 
-    const FT_BBox& bb = gm->bb;
+    const FT_BBox& bb = g->bb;
     //! NOTE Moved form sym.cpp ScoreFont::computeMetrics as is
     double m = 640.0 / dpi_f;
     QRectF bbox;
@@ -116,21 +124,26 @@ QRectF FontEngineFT::bbox(char32_t ucs4, double dpi_f) const
 
 double FontEngineFT::advance(char32_t ucs4, double dpi_f) const
 {
-    FTGlyphMetrics* gm = glyphMetrics(ucs4);
-    if (!gm) {
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+    const FTGlyph* g = glyph(ucs4);
+    if (!g) {
         return 0.0;
     }
 
     //! NOTE Moved form sym.cpp ScoreFont::computeMetrics as is
-    return gm->linearHoriAdvance * dpi_f / 655360.0;
+    return g->linearHoriAdvance * dpi_f / 655360.0;
 }
 
-FTGlyphMetrics* FontEngineFT::glyphMetrics(char32_t ucs4) const
+//! NOTE m_data->mutex must be locked
+FTGlyph* FontEngineFT::glyph(char32_t ucs4) const
 {
-    if (m_data->metrics.contains(ucs4)) {
-        return &m_data->metrics[ucs4];
+    auto it = m_data->glyphs.find(ucs4);
+    if (it != m_data->glyphs.end()) {
+        return it->second.valid ? &it->second : nullptr;
     }
 
+    FTGlyph& g = m_data->glyphs[ucs4];
+
     FT_UInt index = FT_Get_Char_Index(m_data->face, ucs4);
     if (index == 0) {
         return nullptr;
@@ -140,14 +153,12 @@ FTGlyphMetrics* FontEngineFT::glyphMetrics(char32_t ucs4) const
         return nullptr;
     }
 
-    FT_BBox bb;
-    if (FT_Outline_Get_BBox(&m_data->face->glyph->outline, &bb) != 0) {
+    if (FT_Outline_Get_BBox(&m_data->face->glyph->outline, &g.bb) != 0) {
         return nullptr;
     }
 
-    FTGlyphMetrics& gm = m_data->metrics[ucs4];
-    gm.bb = bb;
-    gm.linearHoriAdvance = m_data->face->glyph->linearHoriAdvance;
+    g.linearHoriAdvance = m_data->face->glyph->linearHoriAdvance;
+    g.valid = true;
 
-    return &gm;
+    return &g;
 }
@@ -27,7 +27,7 @@
 
 namespace mu::draw {
 struct FTData;
-struct FTGlyphMetrics;
+struct FTGlyph;
 class FontEngineFT
 {
 public:
@@ -41,7 +41,7 @@ public:
 
 private:
 
-    FTGlyphMetrics* glyphMetrics(char32_t ucs4) const;
+    FTGlyph* glyph(char32_t ucs4) const;
 
     FTData* m_data = nullptr;
 };
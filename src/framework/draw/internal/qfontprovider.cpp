@@ -26,6 +26,8 @@
 #include <QFontDatabase>
 #include <QFontMetricsF>
 
+#include "hashutils.h"
+
 #include "engraving/libmscore/mscore.h"
 #include "fontengineft.h"
 
@@ -54,55 +56,226 @@ protected:
 
 static FontPaintDevice device;
 
+//! NOTE Enough for the distinct syllables, chord symbols and fingerings of a large score
+static constexpr size_t TEXT_METRICS_CACHE_CAPACITY = 16384;
+
+QFontProvider::ResolvedFont::ResolvedFont(const QFontMetricsF& m)
+    : metrics(m)
+{
+    lineSpacing = metrics.lineSpacing();
+    xHeight = metrics.xHeight();
+    height = metrics.height();
+    ascent = metrics.ascent();
+    descent = metrics.descent();
+}
+
+QFontProvider::FontKey::FontKey(const Font& f)
+    : family(f.family()), pointSizeF(f.pointSizeF()), pixelSize(f.pixelSize()), weight(f.weight()), bold(f.bold()),
+    italic(f.italic()), underline(f.underline()), strike(f.strike()), noFontMerging(f.noFontMerging()), hinting(f.hinting())
+{
+}
+
+bool QFontProvider::FontKey::operator==(const FontKey& other) const
+{
+    return family == other.family
+           && pointSizeF == other.pointSizeF
+           && pixelSize == other.pixelSize
+           && weight == other.weight
+           && bold == other.bold
+           && italic == other.italic
+           && underline == other.underline
+           && strike == other.strike
+           && noFontMerging == other.noFontMerging
+           && hinting == other.hinting;
+}
+
+size_t QFontProvider::FontKeyHash::operator()(const FontKey& k) const
+{
+    size_t seed = std::hash<String> {}(k.family);
+    hashCombine(seed, k.pointSizeF);
+    hashCombine(seed, k.pixelSize);
+    hashCombine(seed, static_cast<int>(k.weight));
+    hashCombine(seed, k.bold);
+    hashCombine(seed, k.italic);
+    hashCombine(seed, k.underline);
+    hashCombine(seed, k.strike);
+    hashCombine(seed, k.noFontMerging);
+    hashCombine(seed, static_cast<int>(k.hinting));
+    return seed;
+}
+
+size_t QFontProvider::TextMetricsKeyHash::operator()(const TextMetricsKey& k) const
+{
+    size_t seed = std::hash<String> {}(k.text);
+    hashCombine(seed, k.font.get());
+    hashCombine(seed, static_cast<int>(k.type));
+    return seed;
+}
+
 int QFontProvider::addSymbolFont(const String& family, const io::path_t& path)
 {
-    m_symbolsFonts[family] = path;
-    return QFontDatabase::addApplicationFont(path.toQString());
+    {
+        std::lock_guard<std::mutex> lock(m_symEnginesMutex);
+        m_symbolsFonts[family] = path;
+    }
+
+    int id = QFontDatabase::addApplicationFont(path.toQString());
+    clearMetricsCache();
+    m_fontsChanged.notify();
+    return id;
 }
 
 int QFontProvider::addTextFont(const io::path_t& path)
 {
-    return QFontDatabase::addApplicationFont(path.toQString());
+    int id = QFontDatabase::addApplicationFont(path.toQString());
+    clearMetricsCache();
+    m_fontsChanged.notify();
+    return id;
 }
 
 void QFontProvider::insertSubstitution(const String& familyName, const String& substituteName)
 {
     QFont::insertSubstitution(familyName, substituteName);
+    clearMetricsCache();
+    m_fontsChanged.notify();
+}
+
+async::Notification QFontProvider::fontsChanged() const
+{
+    return m_fontsChanged;
+}
+
+QFontProvider::MetricsCacheStats QFontProvider::metricsCacheStats() const
+{
+    std::lock_guard<std::mutex> lock(m_textMetricsMutex);
+    return m_metricsCacheStats;
+}
+
+//! NOTE Must be called when fonts are registered or substituted, the resolved fonts may change then
+void QFontProvider::clearMetricsCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_textMetricsMutex);
+        m_textMetrics.clear();
+        m_textMetricsLru.clear();
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_resolvedFontsMutex);
+    m_resolvedFonts.clear();
+}
+
+QFontProvider::ResolvedFontPtr QFontProvider::resolvedFont(const Font& f) const
+{
+    FontKey key(f);
+
+    {
+        std::shared_lock<std::shared_mutex> lock(m_resolvedFontsMutex);
+        auto it = m_resolvedFonts.find(key);
+        if (it != m_resolvedFonts.end()) {
+            return it->second;
+        }
+    }
+
+    auto resolved = std::make_shared<const ResolvedFont>(QFontMetricsF(f.toQFont(), &device));
+
+    //! NOTE Another thread may have resolved the same font meanwhile, then its one is used
+    std::unique_lock<std::shared_mutex> lock(m_resolvedFontsMutex);
+    return m_resolvedFonts.emplace(std::move(key), std::move(resolved)).first->second;
+}
+
+//! NOTE The horizontal advance is kept as the width of a rect at the origin
+RectF QFontProvider::textMetrics(const Font& f, TextMetricsType type, const String& string) const
+{
+    TextMetricsKey key { resolvedFont(f), type, string };
+
+    {
+        std::lock_guard<std::mutex> lock(m_textMetricsMutex);
+        auto it = m_textMetrics.find(key);
+        if (it != m_textMetrics.end()) {
+            ++m_metricsCacheStats.hits;
+            m_textMetricsLru.splice(m_textMetricsLru.begin(), m_textMetricsLru, it->second);
+            return it->second->second;
+        }
+
+        ++m_metricsCacheStats.misses;
+    }
+
+    const ResolvedFont& font = *key.font;
+    RectF result;
+    {
+        std::lock_guard<std::mutex> lock(font.mutex);
+        QString qstring = string.toQString();
+        switch (type) {
+        case TextMetricsType::HorizontalAdvance:
+            result = RectF(0.0, 0.0, font.metrics.horizontalAdvance(qstring), 0.0);
+            break;
+        case TextMetricsType::BoundingRect:
+            result = RectF::fromQRectF(font.metrics.boundingRect(qstring));
+            break;
+        case TextMetricsType::TightBoundingRect:
+            result = RectF::fromQRectF(font.metrics.tightBoundingRect(qstring));
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_textMetricsMutex);
+    if (m_textMetrics.find(key) != m_textMetrics.end()) {
+        return result;
+    }
+
+    if (m_textMetricsLru.size() >= TEXT_METRICS_CACHE_CAPACITY) {
+        m_textMetrics.erase(m_textMetricsLru.back().first);
+        m_textMetricsLru.pop_back();
+    }
+
+    m_textMetricsLru.emplace_front(std::move(key), result);
+    m_textMetrics.emplace(m_textMetricsLru.front().first, m_textMetricsLru.begin());
+
+    return result;
 }
 
 double QFontProvider::lineSpacing(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).lineSpacing();
+    return resolvedFont(f)->lineSpacing;
 }
 
 double QFontProvider::xHeight(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).xHeight();
+    return resolvedFont(f)->xHeight;
 }
 
 double QFontProvider::height(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).height();
+    return resolvedFont(f)->height;
 }
 
 double QFontProvider::ascent(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).ascent();
+    return resolvedFont(f)->ascent;
 }
 
 double QFontProvider::descent(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).descent();
+    return resolvedFont(f)->descent;
 }
 
 bool QFontProvider::inFont(const Font& f, Char ch) const
 {
-    return QFontMetricsF(f.toQFont(), &device).inFont(ch);
+    ResolvedFontPtr font = resolvedFont(f);
+    std::lock_guard<std::mutex> lock(font->mutex);
+    return font->metrics.inFont(ch);
 }
 
 bool QFontProvider::inFontUcs4(const Font& f, char32_t ucs4) const
 {
-    if (!QFontMetricsF(f.toQFont(), &device).inFontUcs4(ucs4)) {
+    bool inFont = false;
+    {
+        ResolvedFontPtr font = resolvedFont(f);
+        std::lock_guard<std::mutex> lock(font->mutex);
+        inFont = font->metrics.inFontUcs4(ucs4);
+    }
+
+    if (!inFont) {
         return false;
     }
 
@@ -114,32 +287,38 @@ bool QFontProvider::inFontUcs4(const Font& f, char32_t ucs4) const
 
 double QFontProvider::horizontalAdvance(const Font& f, const String& string) const
 {
-    return QFontMetricsF(f.toQFont(), &device).horizontalAdvance(string);
+    return textMetrics(f, TextMetricsType::HorizontalAdvance, string).width();
 }
 
 double QFontProvider::horizontalAdvance(const Font& f, const Char& ch) const
 {
-    return QFontMetricsF(f.toQFont(), &device).horizontalAdvance(ch);
+    ResolvedFontPtr font = resolvedFont(f);
+    std::lock_guard<std::mutex> lock(font->mutex);
+    return font->metrics.horizontalAdvance(ch);
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const String& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).boundingRect(string));
+    return textMetrics(f, TextMetricsType::BoundingRect, string);
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const Char& ch) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).boundingRect(ch));
+    ResolvedFontPtr font = resolvedFont(f);
+    std::lock_guard<std::mutex> lock(font->mutex);
+    return RectF::fromQRectF(font->metrics.boundingRect(ch));
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const RectF& r, int flags, const String& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).boundingRect(r.toQRectF(), flags, string));
+    ResolvedFontPtr font = resolvedFont(f);
+    std::lock_guard<std::mutex> lock(font->mutex);
+    return RectF::fromQRectF(font->metrics.boundingRect(r.toQRectF(), flags, string));
 }
 
 RectF QFontProvider::tightBoundingRect(const Font& f, const String& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).tightBoundingRect(string));
+    return textMetrics(f, TextMetricsType::TightBoundingRect, string);
 }
 
 // Score symbols
@@ -199,6 +378,8 @@ double QFontProvider::symAdvance(const Font& f, char32_t ucs4, double dpi_f) con
 
 FontEngineFT* QFontProvider::symEngine(const Font& f) const
 {
+    std::lock_guard<std::mutex> lock(m_symEnginesMutex);
+
     QString path = m_symbolsFonts.value(f.family()).toQString();
     if (path.isEmpty()) {
         return nullptr;
@@ -22,7 +22,15 @@
 #ifndef MU_DRAW_QFONTPROVIDER_H
 #define MU_DRAW_QFONTPROVIDER_H
 
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include <QHash>
+#include <QFontMetricsF>
+
 #include "../ifontprovider.h"
 
 namespace mu::draw {
@@ -32,9 +40,17 @@ class QFontProvider : public IFontProvider
 public:
     QFontProvider() = default;
 
+    struct MetricsCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+
+        double hitRate() const { return (hits + misses) > 0 ? double(hits) / double(hits + misses) : 0.0; }
+    };
+
     int addSymbolFont(const String& family, const io::path_t& path) override;
     int addTextFont(const io::path_t& path) override;
     void insertSubstitution(const String& familyName, const String& substituteName) override;
+    async::Notification fontsChanged() const override;
 
     double lineSpacing(const Font& f) const override;
     double xHeight(const Font& f) const override;
@@ -58,12 +74,97 @@ public:
     RectF symBBox(const Font& f, char32_t ucs4, double DPI_F) const override;
     double symAdvance(const Font& f, char32_t ucs4, double DPI_F) const override;
 
+    MetricsCacheStats metricsCacheStats() const;
+    void clearMetricsCache();
+
 private:
 
+    //! NOTE Resolving a Font into QFontMetricsF is the expensive part of every metrics call,
+    //! so it is done once per font, together with the metrics that don't depend on text.
+    //! These never change, the metrics object itself is only used under its mutex
+    struct ResolvedFont {
+        mutable std::mutex mutex;
+        QFontMetricsF metrics;
+        double lineSpacing = 0.0;
+        double xHeight = 0.0;
+        double height = 0.0;
+        double ascent = 0.0;
+        double descent = 0.0;
+
+        ResolvedFont(const QFontMetricsF& m);
+    };
+
+    using ResolvedFontPtr = std::shared_ptr<const ResolvedFont>;
+
+    //! NOTE Everything Font::toQFont() depends on. Font::operator== is fuzzy
+    //! and ignores the pixel size, so it can't be used for the lookup
+    struct FontKey {
+        String family;
+        double pointSizeF = -1.0;
+        int pixelSize = -1;
+        Font::Weight weight = Font::Weight::Normal;
+        bool bold = false;
+        bool italic = false;
+        bool underline = false;
+        bool strike = false;
+        bool noFontMerging = false;
+        Font::Hinting hinting = Font::Hinting::PreferDefaultHinting;
+
+        FontKey(const Font& f);
+
+        bool operator==(const FontKey& other) const;
+    };
+
+    struct FontKeyHash {
+        size_t operator()(const FontKey& k) const;
+    };
+
+    enum class TextMetricsType : unsigned char {
+        HorizontalAdvance,
+        BoundingRect,
+        TightBoundingRect
+    };
+
+    //! NOTE Holds the font, so its address is not reused while the key exists
+    struct TextMetricsKey {
+        ResolvedFontPtr font;
+        TextMetricsType type = TextMetricsType::HorizontalAdvance;
+        String text;
+
+        bool operator==(const TextMetricsKey& other) const
+        {
+            return font == other.font && type == other.type && text == other.text;
+        }
+    };
+
+    struct TextMetricsKeyHash {
+        size_t operator()(const TextMetricsKey& k) const;
+    };
+
+    using TextMetricsList = std::list<std::pair<TextMetricsKey, RectF> >;
+
+    ResolvedFontPtr resolvedFont(const Font& f) const;
+    RectF textMetrics(const Font& f, TextMetricsType type, const String& string) const;
+
     FontEngineFT* symEngine(const Font& f) const;
 
+    //! NOTE Symbol metrics are asked for from the layout of several scores,
+    //! the fonts and engines are only used under this lock, each engine guards its own face
+    mutable std::mutex m_symEnginesMutex;
     QHash<QString /*family*/, io::path_t> m_symbolsFonts;
     mutable QHash<QString /*path*/, FontEngineFT*> m_symEngines;
+
+    //! NOTE The locks are only held for the lookups, metrics are measured outside of them.
+    //! Resolved fonts are mostly looked up, so readers share their lock
+    mutable std::shared_mutex m_resolvedFontsMutex;
+    mutable std::unordered_map<FontKey, ResolvedFontPtr, FontKeyHash> m_resolvedFonts;
+
+    mutable std::mutex m_textMetricsMutex;
+    mutable TextMetricsList m_textMetricsLru;
+    mutable std::unordered_map<TextMetricsKey, TextMetricsList::iterator, TextMetricsKeyHash> m_textMetrics;
+    mutable MetricsCacheStats m_metricsCacheStats;
+
+    async::Notification m_fontsChanged;
 };
 }
 
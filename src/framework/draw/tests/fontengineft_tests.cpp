@@ -0,0 +1,75 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "draw/internal/fontengineft.h"
+
+using namespace mu;
+using namespace mu::draw;
+
+static const double DPI_F = 5.0;
+static const char32_t NOTEHEAD_BLACK = 0xE0A4;
+static const char32_t EMPTY_GLYPH = 0xE0A5; // mapped in Bravura, with an advance but no contours
+static const char32_t NOT_MAPPED = 0x10FFFD;
+
+class Draw_FontEngineFTTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_engine.load(io::path_t(draw_tests_DATA_ROOT) + "/bravura/Bravura.otf"));
+    }
+
+protected:
+    FontEngineFT m_engine;
+};
+
+TEST_F(Draw_FontEngineFTTests, Metrics_CachedPerGlyph)
+{
+    //! DO Get the metrics twice, and for a doubled dpi
+    QRectF bbox = m_engine.bbox(NOTEHEAD_BLACK, DPI_F);
+    QRectF again = m_engine.bbox(NOTEHEAD_BLACK, DPI_F);
+    QRectF doubled = m_engine.bbox(NOTEHEAD_BLACK, DPI_F * 2);
+
+    //! CHECK Repeated requests return the same metrics
+    ASSERT_TRUE(bbox.isValid());
+    EXPECT_EQ(again, bbox);
+    EXPECT_DOUBLE_EQ(m_engine.advance(NOTEHEAD_BLACK, DPI_F), m_engine.advance(NOTEHEAD_BLACK, DPI_F));
+
+    //! CHECK The cached glyph is scaled for the requested dpi
+    EXPECT_NEAR(doubled.width(), bbox.width() * 2, 1e-6);
+    EXPECT_NEAR(doubled.height(), bbox.height() * 2, 1e-6);
+    EXPECT_NEAR(m_engine.advance(NOTEHEAD_BLACK, DPI_F * 2), m_engine.advance(NOTEHEAD_BLACK, DPI_F) * 2, 1e-6);
+}
+
+TEST_F(Draw_FontEngineFTTests, MissingGlyph)
+{
+    //! DO Ask twice for glyphs the font can't draw
+    for (int i = 0; i < 2; ++i) {
+        //! CHECK Both the cached and the uncached answer are empty
+        EXPECT_GT(m_engine.advance(EMPTY_GLYPH, DPI_F), 0.0);
+        EXPECT_FALSE(m_engine.bbox(EMPTY_GLYPH, DPI_F).isValid());
+
+        EXPECT_DOUBLE_EQ(m_engine.advance(NOT_MAPPED, DPI_F), 0.0);
+        EXPECT_FALSE(m_engine.bbox(NOT_MAPPED, DPI_F).isValid());
+    }
+}
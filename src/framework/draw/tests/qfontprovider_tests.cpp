@@ -0,0 +1,154 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include <QFontMetricsF>
+
+#include "draw/internal/qfontprovider.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::draw;
+
+class Draw_QFontProviderTests : public ::testing::Test
+{
+public:
+};
+
+static Font makeFont(double pointSize, bool italic = false)
+{
+    Font font(u"Edwin", Font::Type::Text);
+    font.setPointSizeF(pointSize);
+    font.setItalic(italic);
+    return font;
+}
+
+TEST_F(Draw_QFontProviderTests, TextMetrics_CachedResultsAreStable)
+{
+    //! GIVEN Font provider and a font
+    QFontProvider provider;
+    Font font = makeFont(10.0);
+
+    //! DO Measure the same text twice
+    double advance = provider.horizontalAdvance(font, u"Kyrie");
+    RectF bbox = provider.boundingRect(font, u"Kyrie");
+    RectF tightBBox = provider.tightBoundingRect(font, u"Kyrie");
+
+    //! CHECK First calls are misses
+    EXPECT_EQ(provider.metricsCacheStats().hits, 0u);
+    EXPECT_EQ(provider.metricsCacheStats().misses, 3u);
+
+    //! CHECK Second calls are hits and return the same results
+    EXPECT_EQ(provider.horizontalAdvance(font, u"Kyrie"), advance);
+    EXPECT_EQ(provider.boundingRect(font, u"Kyrie"), bbox);
+    EXPECT_EQ(provider.tightBoundingRect(font, u"Kyrie"), tightBBox);
+
+    EXPECT_EQ(provider.metricsCacheStats().hits, 3u);
+    EXPECT_EQ(provider.metricsCacheStats().misses, 3u);
+    EXPECT_DOUBLE_EQ(provider.metricsCacheStats().hitRate(), 0.5);
+}
+
+TEST_F(Draw_QFontProviderTests, TextMetrics_DependOnFont)
+{
+    //! GIVEN Font provider and two different fonts
+    QFontProvider provider;
+    Font small = makeFont(10.0);
+    Font large = makeFont(20.0, true);
+
+    //! DO Measure the same text with both fonts
+    double smallAdvance = provider.horizontalAdvance(small, u"eleison");
+    double largeAdvance = provider.horizontalAdvance(large, u"eleison");
+
+    //! CHECK Results are not shared between fonts
+    EXPECT_EQ(provider.metricsCacheStats().misses, 2u);
+    EXPECT_LT(smallAdvance, largeAdvance);
+    EXPECT_DOUBLE_EQ(largeAdvance, provider.horizontalAdvance(large, u"eleison"));
+    EXPECT_LT(provider.lineSpacing(small), provider.lineSpacing(large));
+}
+
+TEST_F(Draw_QFontProviderTests, TextMetrics_DependOnPixelSize)
+{
+    //! GIVEN Font provider and two fonts which only differ in their pixel size
+    QFontProvider provider;
+    Font small(u"Edwin", Font::Type::Text);
+    small.setPixelSize(10);
+    Font large(u"Edwin", Font::Type::Text);
+    large.setPixelSize(40);
+
+    //! DO Measure the same text with both fonts
+    double smallAdvance = provider.horizontalAdvance(small, u"eleison");
+    double largeAdvance = provider.horizontalAdvance(large, u"eleison");
+
+    //! CHECK They are resolved separately
+    EXPECT_EQ(provider.metricsCacheStats().misses, 2u);
+    EXPECT_LT(smallAdvance, largeAdvance);
+    EXPECT_LT(provider.lineSpacing(small), provider.lineSpacing(large));
+}
+
+//! NOTE Simulates text layout of a choral score: four voices singing the same syllables,
+//! every syllable measured several times per layout, with a few distinct fonts
+TEST_F(Draw_QFontProviderTests, DISABLED_TextMetrics_ChoralBenchmark)
+{
+    const std::vector<String> syllables = {
+        u"Ky", u"ri", u"e", u"e", u"le", u"i", u"son", u"Chri", u"ste", u"Glo", u"ri", u"a",
+        u"in", u"ex", u"cel", u"sis", u"De", u"o", u"et", u"in", u"ter", u"ra", u"pax", u"ho",
+        u"mi", u"ni", u"bus", u"bo", u"nae", u"vo", u"lun", u"ta", u"tis", u"Lau", u"da", u"mus", u"te"
+    };
+    const std::vector<Font> fonts = { makeFont(10.0), makeFont(10.0, true), makeFont(9.0) };
+
+    constexpr int VOICES = 4;
+    constexpr int REPEATS = 500;
+
+    QFontProvider provider;
+
+    auto measure = [&](auto func) {
+        double sum = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        for (int repeat = 0; repeat < REPEATS; ++repeat) {
+            for (int voice = 0; voice < VOICES; ++voice) {
+                for (const String& syllable : syllables) {
+                    sum += func(fonts.at((repeat + voice) % fonts.size()), syllable);
+                }
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        LOGI() << "checksum: " << sum;
+        return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    };
+
+    auto uncached = measure([](const Font& font, const String& text) {
+        QFontMetricsF metrics(font.toQFont());
+        return metrics.horizontalAdvance(text) + metrics.boundingRect(text).width() + metrics.tightBoundingRect(text).width();
+    });
+
+    auto cached = measure([&provider](const Font& font, const String& text) {
+        return provider.horizontalAdvance(font, text) + provider.boundingRect(font, text).width()
+               + provider.tightBoundingRect(font, text).width();
+    });
+
+    QFontProvider::MetricsCacheStats stats = provider.metricsCacheStats();
+    LOGI() << "uncached: " << uncached << " us, cached: " << cached << " us"
+           << ", hits: " << stats.hits << ", misses: " << stats.misses << ", hit rate: " << stats.hitRate();
+}
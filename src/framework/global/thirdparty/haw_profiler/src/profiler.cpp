@@ -10,9 +10,13 @@
 using namespace haw::profiler;
 
 Profiler::Options Profiler::m_options;
+std::atomic<bool> Profiler::s_timelineEnabled(false);
 
 constexpr int MAIN_THREAD_INDEX(0);
 
+using timeline_clock = std::chrono::steady_clock;
+static const timeline_clock::time_point s_timelineStart = timeline_clock::now();
+
 Profiler* Profiler::instance()
 {
     static Profiler p;
@@ -78,6 +82,17 @@ void Profiler::stepTime(const std::string& tag, const std::string& info, bool is
 
     printer()->printStep(tag, timer->beginMs(), timer->stepMs(), info);
 
+    if (timelineEnabled()) {
+        TimelineEvent step;
+        step.type = TimelineEvent::Step;
+        step.name = tag + ": " + info;
+        step.thread = timelineBuffer()->index;
+        step.beginUs = timelineNowUs();
+
+        std::lock_guard<std::mutex> timelineLock(m_timeline.mutex);
+        m_timeline.steps.push_back(std::move(step));
+    }
+
     timer->nextStep();
 }
 
@@ -170,6 +185,13 @@ void Profiler::clear()
         }
         m_steps.timers.clear();
     }
+    {
+        std::lock_guard<std::mutex> lock(m_timeline.mutex);
+        for (auto& buf : m_timeline.buffers) {
+            buf->tail.store(buf->head.load(std::memory_order_acquire), std::memory_order_release);
+        }
+        m_timeline.steps.clear();
+    }
 }
 
 Profiler::Data Profiler::threadsData(Data::Mode mode) const
@@ -253,6 +275,204 @@ bool Profiler::save(const std::string& filePath)
     return ok;
 }
 
+void Profiler::setTimelineEnabled(bool arg)
+{
+    s_timelineEnabled.store(arg, std::memory_order_relaxed);
+}
+
+bool Profiler::timelineEnabled()
+{
+    return s_timelineEnabled.load(std::memory_order_relaxed);
+}
+
+uint64_t Profiler::timelineNowUs()
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(timeline_clock::now() - s_timelineStart);
+    return static_cast<uint64_t>(elapsed.count());
+}
+
+Profiler::TimelineBufferOwner::~TimelineBufferOwner()
+{
+    if (buffer) {
+        Profiler::instance()->releaseTimelineBuffer(buffer);
+    }
+}
+
+Profiler::TimelineBuffer* Profiler::timelineBuffer()
+{
+    //! NOTE There is only one profiler, so the buffer of the thread can be cached
+    thread_local TimelineBufferOwner owner;
+    if (owner.buffer) {
+        return owner.buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(m_timeline.mutex);
+
+    //! NOTE Short-lived worker threads would otherwise add a buffer each.
+    //! A reused buffer keeps the events of its previous thread, they don't overlap in time
+    //! with the new ones, so the trace shows them on the same row, as for a pooled thread
+    if (!m_timeline.released.empty()) {
+        owner.buffer = m_timeline.released.back();
+        m_timeline.released.pop_back();
+        owner.buffer->thread = std::this_thread::get_id();
+        return owner.buffer;
+    }
+
+    size_t capacity = m_options.timelineBufferSize < 1 ? 1 : m_options.timelineBufferSize;
+    size_t index = m_timeline.buffers.size();
+    m_timeline.buffers.push_back(std::make_unique<TimelineBuffer>(std::this_thread::get_id(), index, capacity));
+    owner.buffer = m_timeline.buffers.back().get();
+    return owner.buffer;
+}
+
+void Profiler::releaseTimelineBuffer(TimelineBuffer* buffer)
+{
+    std::lock_guard<std::mutex> lock(m_timeline.mutex);
+    m_timeline.released.push_back(buffer);
+}
+
+void Profiler::TimelineBuffer::push(const std::string* name, uint64_t beginUs, uint64_t endUs)
+{
+    uint64_t h = head.load(std::memory_order_relaxed);
+
+    //! NOTE Orders the previous head store before the slot stores, pairs with the fence in timelineEvents
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Slot& slot = slots[h % slots.size()];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.beginUs.store(beginUs, std::memory_order_relaxed);
+    slot.endUs.store(endUs, std::memory_order_relaxed);
+    head.store(h + 1, std::memory_order_release);
+}
+
+void Profiler::addTimelineEvent(const std::string& func, uint64_t beginUs, uint64_t endUs)
+{
+    timelineBuffer()->push(&func, beginUs, endUs);
+}
+
+std::vector<Profiler::TimelineEvent> Profiler::timelineEvents() const
+{
+    std::vector<TimelineEvent> events;
+
+    std::lock_guard<std::mutex> lock(m_timeline.mutex);
+    for (const auto& buf : m_timeline.buffers) {
+        const uint64_t capacity = buf->slots.size();
+        const uint64_t tail = buf->tail.load(std::memory_order_acquire);
+        const uint64_t headBefore = buf->head.load(std::memory_order_acquire);
+        uint64_t from = headBefore > capacity ? headBefore - capacity : 0;
+        from = std::max(from, tail);
+
+        std::vector<TimelineEvent> threadEvents;
+        threadEvents.reserve(static_cast<size_t>(headBefore - from));
+        for (uint64_t i = from; i < headBefore; ++i) {
+            const TimelineBuffer::Slot& slot = buf->slots[i % capacity];
+            TimelineEvent e;
+            e.type = TimelineEvent::Func;
+            const std::string* name = slot.name.load(std::memory_order_relaxed);
+            e.name = name ? *name : std::string();
+            e.thread = buf->index;
+            e.beginUs = slot.beginUs.load(std::memory_order_relaxed);
+            uint64_t endUs = slot.endUs.load(std::memory_order_relaxed);
+            e.durUs = endUs > e.beginUs ? endUs - e.beginUs : 0;
+            threadEvents.push_back(std::move(e));
+        }
+
+        //! NOTE The owner thread may have overwritten the oldest slots while we were reading them.
+        //! If a slot load above saw an overwrite, the fence makes the head that preceded it visible here
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t headAfter = buf->head.load(std::memory_order_relaxed);
+        const uint64_t firstIntact = headAfter >= capacity ? headAfter - capacity + 1 : 0;
+        size_t skip = firstIntact > from ? static_cast<size_t>(std::min(firstIntact, headBefore) - from) : 0;
+
+        events.insert(events.end(), threadEvents.begin() + skip, threadEvents.end());
+    }
+
+    events.insert(events.end(), m_timeline.steps.begin(), m_timeline.steps.end());
+
+    std::stable_sort(events.begin(), events.end(), [](const TimelineEvent& f, const TimelineEvent& s) {
+        return f.beginUs < s.beginUs;
+    });
+
+    return events;
+}
+
+static std::string jsonEscaped(const std::string& str)
+{
+    std::string res;
+    res.reserve(str.size() + 2);
+    for (char c : str) {
+        switch (c) {
+        case '"': res.append("\\\""); break;
+        case '\\': res.append("\\\\"); break;
+        case '\n': res.append("\\n"); break;
+        case '\t': res.append("\\t"); break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                res.append(" ");
+            } else {
+                res.push_back(c);
+            }
+        }
+    }
+    return res;
+}
+
+std::string Profiler::timelineJson() const
+{
+    std::vector<TimelineEvent> events = timelineEvents();
+
+    std::vector<std::thread::id> threads;
+    {
+        std::lock_guard<std::mutex> lock(m_timeline.mutex);
+        for (const auto& buf : m_timeline.buffers) {
+            threads.push_back(buf->thread);
+        }
+    }
+
+    std::thread::id mainThread;
+    {
+        std::lock_guard<std::mutex> lock(m_funcs.mutex);
+        mainThread = m_funcs.threads[MAIN_THREAD_INDEX];
+    }
+
+    std::stringstream stream;
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    auto sep = [&stream, &first]() {
+        stream << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    for (size_t i = 0; i < threads.size(); ++i) {
+        std::string name = threads[i] == mainThread ? "Main thread" : "Thread " + std::to_string(i);
+        sep();
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+               << ",\"args\":{\"name\":\"" << name << "\"}}";
+    }
+
+    for (const TimelineEvent& e : events) {
+        sep();
+        stream << "{\"name\":\"" << jsonEscaped(e.name) << "\",";
+        if (e.type == TimelineEvent::Func) {
+            stream << "\"cat\":\"func\",\"ph\":\"X\",\"ts\":" << e.beginUs << ",\"dur\":" << e.durUs;
+        } else {
+            stream << "\"cat\":\"step\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << e.beginUs;
+        }
+        stream << ",\"pid\":1,\"tid\":" << e.thread << "}";
+    }
+
+    stream << "\n]}\n";
+    return stream.str();
+}
+
+bool Profiler::saveTimeline(const std::string& filePath)
+{
+    std::string content = timelineJson();
+    bool ok = save_file(filePath, content);
+    return ok;
+}
+
 bool Profiler::save_file(const std::string& path, const std::string& content)
 {
     FILE* pFile = fopen(path.c_str(), "w");
@@ -1,8 +1,11 @@
 #ifndef HAW_PROFILER_H
 #define HAW_PROFILER_H
 
+#include <cstdint>
 #include <string>
 #include <list>
+#include <memory>
+#include <atomic>
 #include <vector>
 #include <set>
 #include <unordered_map>
@@ -53,6 +56,10 @@
 #define PROFILER_PRINT haw::profiler::Profiler::instance()->printThreadsData();
 #endif
 
+#ifndef PROFILER_SAVE_TIMELINE
+#define PROFILER_SAVE_TIMELINE(path) haw::profiler::Profiler::instance()->saveTimeline(path);
+#endif
+
 #else
 
 #define TRACEFUNC
@@ -61,6 +68,7 @@
 #define STEP_TIME
 #define PROFILER_CLEAR
 #define PROFILER_PRINT
+#define PROFILER_SAVE_TIMELINE(path)
 
 #endif
 
@@ -77,6 +85,7 @@ public:
         bool funcsTraceEnabled{ false };
         size_t funcsMaxThreadCount{ 100 };
         int dataTopCount{ 150 };
+        size_t timelineBufferSize{ 32768 }; //! NOTE Events kept per thread, older ones are overwritten
         Options() {}
     };
 
@@ -105,6 +114,19 @@ public:
         std::unordered_map<std::thread::id, Thread> threads;
     };
 
+    struct TimelineEvent {
+        enum Type {
+            Func,
+            Step
+        };
+
+        Type type{ Func };
+        std::string name;
+        size_t thread{ 0 };
+        uint64_t beginUs{ 0 };
+        uint64_t durUs{ 0 };
+    };
+
     struct Printer {
         virtual ~Printer();
         virtual void printDebug(const std::string& str);
@@ -161,6 +183,16 @@ public:
 
     bool save(const std::string& filePath);
 
+    //! NOTE The timeline records begin/end of every traced function per thread,
+    //! it is independent of setup, so it can be enabled before the profiler is set up
+    void setTimelineEnabled(bool arg);
+    static bool timelineEnabled();
+    static uint64_t timelineNowUs();
+    void addTimelineEvent(const std::string& func, uint64_t beginUs, uint64_t endUs); //! NOTE func must outlive the profiler
+    std::vector<TimelineEvent> timelineEvents() const;
+    std::string timelineJson() const; //! NOTE Chrome trace event format, opens in chrome://tracing and Perfetto
+    bool saveTimeline(const std::string& filePath);
+
 private:
     Profiler();
     ~Profiler();
@@ -197,12 +229,52 @@ private:
         int addThread(std::thread::id th);
     };
 
+    //! NOTE Single producer ring buffer, only the owner thread writes,
+    //! readers take a snapshot and drop the slots that may have been overwritten meanwhile
+    struct TimelineBuffer {
+        struct Slot {
+            std::atomic<const std::string*> name{ nullptr };
+            std::atomic<uint64_t> beginUs{ 0 };
+            std::atomic<uint64_t> endUs{ 0 };
+        };
+
+        TimelineBuffer(std::thread::id th, size_t idx, size_t capacity)
+            : thread(th), index(idx), slots(capacity) {}
+
+        std::thread::id thread; //! NOTE The last thread that owned the buffer
+        size_t index{ 0 };
+        std::vector<Slot> slots;
+        std::atomic<uint64_t> head{ 0 };
+        std::atomic<uint64_t> tail{ 0 };
+
+        void push(const std::string* name, uint64_t beginUs, uint64_t endUs);
+    };
+
+    //! NOTE Gives the buffer back when its thread exits
+    struct TimelineBufferOwner {
+        TimelineBuffer* buffer{ nullptr };
+        ~TimelineBufferOwner();
+    };
+
+    struct TimelineData {
+        mutable std::mutex mutex; //! NOTE Not used on func enter/exit, only on thread registration, steps and reading
+        std::vector<std::unique_ptr<TimelineBuffer> > buffers;
+        std::vector<TimelineBuffer*> released; //! NOTE Buffers of exited threads, reused by new threads
+        std::vector<TimelineEvent> steps;
+    };
+
+    TimelineBuffer* timelineBuffer();
+    void releaseTimelineBuffer(TimelineBuffer* buffer);
+
     bool save_file(const std::string& path, const std::string& content);
 
     Printer* m_printer{ nullptr };
 
     StepsData m_steps;
     mutable FuncsData m_funcs;
+    TimelineData m_timeline;
+
+    static std::atomic<bool> s_timelineEnabled;
 
     size_t m_stackCounter{ 0 };
 };
@@ -215,6 +287,11 @@ struct FuncMarker
         if (Profiler::m_options.funcsTimeEnabled) {
             timer = Profiler::instance()->beginFunc(fn);
         }
+
+        if (Profiler::timelineEnabled()) {
+            isTimeline = true;
+            timelineBeginUs = Profiler::timelineNowUs();
+        }
     }
 
     ~FuncMarker()
@@ -222,12 +299,18 @@ struct FuncMarker
         if (Profiler::m_options.funcsTimeEnabled) {
             Profiler::instance()->endFunc(timer, func);
         }
+
+        if (isTimeline) {
+            Profiler::instance()->addTimelineEvent(func, timelineBeginUs, Profiler::timelineNowUs());
+        }
     }
 
     static std::string formatSig(const std::string& sig);
 
     Profiler::FuncTimer* timer{ nullptr };
     const std::string& func;
+    bool isTimeline{ false };
+    uint64_t timelineBeginUs{ 0 };
 };
 }
 
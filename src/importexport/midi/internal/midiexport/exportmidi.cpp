@@ -22,6 +22,9 @@
 
 #include "exportmidi.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "libmscore/key.h"
 #include "libmscore/masterscore.h"
 #include "libmscore/note.h"
@@ -239,14 +242,52 @@ bool ExportMidi::write(QIODevice* device, bool midiExpandRepeats, bool exportRPN
     m_pauseMap.calculate(m_score);
     writeHeader();
 
-    int staffIdx = 0;
-    for (auto& track: tracks) {
+    std::vector<std::unique_ptr<MidiTrackStream> > streams;
+    writeTracks(events, exportRPNs, streams);
+
+    return !m_midiFile.write(device, streams);
+}
+
+//---------------------------------------------------------
+//   writeTracks
+//    Every track gets the events of the channels of its part,
+//    in the order of the channels and then of the events for the same tick.
+//    The rendered events are walked once and dispatched to the tracks,
+//    events of the current tick are merged with the header events of the track
+//    and encoded right away, so no track keeps all its events.
+//---------------------------------------------------------
+
+void ExportMidi::writeTracks(const EventMap& events, bool exportRPNs, std::vector<std::unique_ptr<MidiTrackStream> >& streams)
+{
+    struct TrackChannel {
+        char port = 0;
+        char channel = 0;
+    };
+
+    struct TrackState {
+        std::vector<TrackChannel> channels;
+        std::multimap<int, MidiEvent>::const_iterator headerIt;
+        std::multimap<int, MidiEvent>::const_iterator headerEnd;
+        // <channel index, event> of the current tick
+        std::vector<std::pair<size_t, MidiEvent> > pending;
+    };
+
+    std::vector<MidiTrack>& tracks = m_midiFile.tracks();
+    std::vector<TrackState> states(tracks.size());
+
+    for (size_t staffIdx = 0; staffIdx < tracks.size(); ++staffIdx) {
+        MidiTrack& track = tracks[staffIdx];
+        TrackState& state = states[staffIdx];
         Staff* staff = m_score->staff(staffIdx);
         Part* part   = staff->part();
 
         track.setOutPort(part->midiPort());
         track.setOutChannel(part->midiChannel());
 
+        streams.push_back(std::make_unique<MidiTrackStream>());
+        state.headerIt = track.events().cbegin();
+        state.headerEnd = track.events().cend();
+
         // Pass through the all instruments in the part
         for (const auto& pair : part->instruments()) {
             // Pass through the all channels of the instrument
@@ -257,34 +298,41 @@ bool ExportMidi::write(QIODevice* device, bool midiExpandRepeats, bool exportRPN
                 char port    = part->masterScore()->midiPort(ch->channel());
                 char channel = part->masterScore()->midiChannel(ch->channel());
 
+                size_t channelIdx = state.channels.size();
+                state.channels.push_back({ port, channel });
+
+                auto addInitial = [&](const MidiEvent& ev) {
+                    state.pending.push_back({ channelIdx, ev });
+                };
+
                 if (staff->isTop()) {
-                    track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_RESET_ALL_CTRL, 0));
+                    addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_RESET_ALL_CTRL, 0));
                     // We need this to get the correct pitch of bends
                     // Hidden under preferences because some software
                     // crashes when receiving RPNs: https://musescore.org/en/node/37431
                     if (channel != 9 && exportRPNs) {
                         // set pitch bend sensitivity to 12 semitones:
-                        track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_LRPN, 0));
-                        track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_HRPN, 0));
-                        track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_HDATA, 12));
+                        addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_LRPN, 0));
+                        addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_HRPN, 0));
+                        addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_HDATA, 12));
 
                         // reset fine tuning
-                        /*track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_LRPN, 1));
-                        track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_HRPN, 0));
-                        track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_HDATA, 64));*/
+                        /*addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_LRPN, 1));
+                        addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_HRPN, 0));
+                        addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_HDATA, 64));*/
 
                         // deactivate rpn
-                        track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_LRPN, 127));
-                        track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_HRPN, 127));
+                        addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_LRPN, 127));
+                        addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_HRPN, 127));
                     }
 
                     if (ch->program() != -1) {
-                        track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_PROGRAM, ch->program()));
+                        addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_PROGRAM, ch->program()));
                     }
-                    track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_VOLUME, ch->volume()));
-                    track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_PANPOT, ch->pan()));
-                    track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_REVERB_SEND, ch->reverb()));
-                    track.insert(0, MidiEvent(ME_CONTROLLER, channel, CTRL_CHORUS_SEND, ch->chorus()));
+                    addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_VOLUME, ch->volume()));
+                    addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_PANPOT, ch->pan()));
+                    addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_REVERB_SEND, ch->reverb()));
+                    addInitial(MidiEvent(ME_CONTROLLER, channel, CTRL_CHORUS_SEND, ch->chorus()));
                 }
 
                 // Export port to MIDI META event
@@ -296,65 +344,108 @@ bool ExportMidi::write(QIODevice* device, bool midiExpandRepeats, bool exportRPN
                     unsigned char* data = new unsigned char[1];
                     data[0] = int(track.outPort());
                     ev.setEData(data);
-                    track.insert(0, ev);
+                    addInitial(ev);
                 }
+            }
+        }
+    }
 
-                for (auto i = events.begin(); i != events.end(); ++i) {
-                    const NPlayEvent& event = i->second;
+    // header events go first, then the events of the tick in the order of channels
+    auto flush = [&](int tick) {
+        for (size_t trackIdx = 0; trackIdx < states.size(); ++trackIdx) {
+            TrackState& state = states[trackIdx];
+            MidiTrackStream& stream = *streams[trackIdx];
 
-                    if (event.isMuted()) {
-                        continue;
-                    }
-                    if (event.discard() == staffIdx + 1 && event.velo() > 0) {
-                        // turn note off so we can restrike it in another track
-                        track.insert(m_pauseMap.addPauseTicks(i->first), MidiEvent(ME_NOTEON, channel,
-                                                                                   event.pitch(), 0));
-                    }
+            for (; state.headerIt != state.headerEnd && state.headerIt->first <= tick; ++state.headerIt) {
+                m_midiFile.writeEvent(stream, state.headerIt->first, state.headerIt->second);
+            }
 
-                    if (event.getOriginatingStaff() != staffIdx) {
-                        continue;
-                    }
+            if (state.pending.empty()) {
+                continue;
+            }
 
-                    if (event.discard() && event.velo() == 0) {
-                        // ignore noteoff but restrike noteon
-                        continue;
-                    }
+            std::stable_sort(state.pending.begin(), state.pending.end(),
+                             [](const std::pair<size_t, MidiEvent>& e1, const std::pair<size_t, MidiEvent>& e2) {
+                return e1.first < e2.first;
+            });
 
-                    if (!exportRPNs && event.type() == ME_CONTROLLER && event.portamento()) {
-                        // ignore portamento control events if exportRPN isn't switched on
-                        continue;
-                    }
+            for (const auto& pending : state.pending) {
+                m_midiFile.writeEvent(stream, tick, pending.second);
+            }
+            state.pending.clear();
+        }
+    };
 
-                    char eventPort    = m_score->masterScore()->midiPort(event.channel());
-                    char eventChannel = m_score->masterScore()->midiChannel(event.channel());
-                    if (port != eventPort || channel != eventChannel) {
-                        continue;
-                    }
+    int currentTick = 0;
+    const int tracksCount = static_cast<int>(states.size());
 
-                    if (event.type() == ME_NOTEON) {
-                        // use the note values instead of the event values if portamento is suppressed
-                        if (!exportRPNs && event.portamento()) {
-                            track.insert(m_pauseMap.addPauseTicks(i->first), MidiEvent(ME_NOTEON, channel,
-                                                                                       event.note()->pitch(), event.velo()));
-                        } else {
-                            track.insert(m_pauseMap.addPauseTicks(i->first), MidiEvent(ME_NOTEON, channel,
-                                                                                       event.pitch(), event.velo()));
-                        }
-                    } else if (event.type() == ME_CONTROLLER) {
-                        track.insert(m_pauseMap.addPauseTicks(i->first), MidiEvent(ME_CONTROLLER, channel,
-                                                                                   event.controller(), event.value()));
-                    } else if (event.type() == ME_PITCHBEND) {
-                        track.insert(m_pauseMap.addPauseTicks(i->first), MidiEvent(ME_PITCHBEND, channel,
-                                                                                   event.dataA(), event.dataB()));
-                    } else {
-                        LOGD("writeMidi: unknown midi event 0x%02x", event.type());
-                    }
+    for (auto i = events.begin(); i != events.end(); ++i) {
+        const NPlayEvent& event = i->second;
+
+        if (event.isMuted()) {
+            continue;
+        }
+
+        int tick = m_pauseMap.addPauseTicks(i->first);
+        if (tick != currentTick) {
+            flush(currentTick);
+            currentTick = tick;
+        }
+
+        int discardStaffIdx = event.discard() - 1;
+        if (discardStaffIdx >= 0 && discardStaffIdx < tracksCount && event.velo() > 0) {
+            // turn note off so we can restrike it in another track
+            TrackState& state = states[discardStaffIdx];
+            for (size_t channelIdx = 0; channelIdx < state.channels.size(); ++channelIdx) {
+                state.pending.push_back({ channelIdx, MidiEvent(ME_NOTEON, state.channels[channelIdx].channel, event.pitch(), 0) });
+            }
+        }
+
+        int staffIdx = event.getOriginatingStaff();
+        if (staffIdx < 0 || staffIdx >= tracksCount) {
+            continue;
+        }
+
+        if (event.discard() && event.velo() == 0) {
+            // ignore noteoff but restrike noteon
+            continue;
+        }
+
+        if (!exportRPNs && event.type() == ME_CONTROLLER && event.portamento()) {
+            // ignore portamento control events if exportRPN isn't switched on
+            continue;
+        }
+
+        char eventPort    = m_score->masterScore()->midiPort(event.channel());
+        char eventChannel = m_score->masterScore()->midiChannel(event.channel());
+
+        TrackState& state = states[staffIdx];
+        for (size_t channelIdx = 0; channelIdx < state.channels.size(); ++channelIdx) {
+            char port    = state.channels[channelIdx].port;
+            char channel = state.channels[channelIdx].channel;
+            if (port != eventPort || channel != eventChannel) {
+                continue;
+            }
+
+            if (event.type() == ME_NOTEON) {
+                // use the note values instead of the event values if portamento is suppressed
+                if (!exportRPNs && event.portamento()) {
+                    state.pending.push_back({ channelIdx, MidiEvent(ME_NOTEON, channel, event.note()->pitch(), event.velo()) });
+                } else {
+                    state.pending.push_back({ channelIdx, MidiEvent(ME_NOTEON, channel, event.pitch(), event.velo()) });
                 }
+            } else if (event.type() == ME_CONTROLLER) {
+                state.pending.push_back({ channelIdx, MidiEvent(ME_CONTROLLER, channel, event.controller(), event.value()) });
+            } else if (event.type() == ME_PITCHBEND) {
+                state.pending.push_back({ channelIdx, MidiEvent(ME_PITCHBEND, channel, event.dataA(), event.dataB()) });
+            } else {
+                LOGD("writeMidi: unknown midi event 0x%02x", event.type());
             }
         }
-        ++staffIdx;
     }
-    return !m_midiFile.write(device);
+
+    flush(currentTick);
+    flush(std::numeric_limits<int>::max());
 }
 
 bool ExportMidi::write(const QString& name, bool midiExpandRepeats, bool exportRPNs, const SynthesizerState& synthState)
@@ -390,7 +481,7 @@ void ExportMidi::PauseMap::calculate(const Score* s)
     TimeSigMap* sigmap = s->sigmap();
     TempoMap* tempomap = s->tempomap();
 
-    this->insert(std::pair<const int, int>(0, 0));    // can't start with a pause
+    this->insert(0, 0);    // can't start with a pause
 
     tempomapWithPauses = new TempoMap();
     tempomapWithPauses->setTempoMultiplier(tempomap->tempoMultiplier());
@@ -419,7 +510,7 @@ void ExportMidi::PauseMap::calculate(const Score* s)
                     qreal quarterNotesPerMeasure = (4.0 * timeSig.numerator()) / timeSig.denominator();
                     int ticksPerMeasure =  quarterNotesPerMeasure * Constants::division;           // store a full measure of ticks to keep barlines in same places
                     tempomapWithPauses->setTempo(this->addPauseTicks(utick), quarterNotesPerMeasure / it->second.pause);           // new tempo for pause
-                    this->insert(std::pair<const int, int>(utick, ticksPerMeasure + this->offsetAtUTick(utick)));            // store running total of extra ticks
+                    this->insert(utick, ticksPerMeasure + this->offsetAtUTick(utick));            // store running total of extra ticks
                     tempomapWithPauses->setTempo(this->addPauseTicks(utick), it->second.tempo);           // restore previous tempo
                 }
             }
@@ -434,11 +525,28 @@ void ExportMidi::PauseMap::calculate(const Score* s)
 
 int ExportMidi::PauseMap::offsetAtUTick(int utick) const
 {
-    Q_ASSERT(!this->empty());   // make sure calculate was called
-    auto i = upper_bound(utick);
-    if (i != begin()) {
+    Q_ASSERT(!m_offsets.empty());   // make sure calculate was called
+    auto i = std::upper_bound(m_offsets.cbegin(), m_offsets.cend(), utick,
+                              [](int tick, const std::pair<int, int>& item) { return tick < item.first; });
+    if (i != m_offsets.cbegin()) {
         --i;
     }
     return i->second;
 }
+
+//---------------------------------------------------------
+//   PauseMap::insert
+//    Keeps the offsets sorted by utick and, like a map,
+//    the first offset inserted for a utick.
+//---------------------------------------------------------
+
+void ExportMidi::PauseMap::insert(int utick, int offset)
+{
+    auto i = std::lower_bound(m_offsets.begin(), m_offsets.end(), utick,
+                              [](const std::pair<int, int>& item, int tick) { return item.first < tick; });
+    if (i != m_offsets.end() && i->first == utick) {
+        return;
+    }
+    m_offsets.insert(i, { utick, offset });
+}
 }
@@ -28,6 +28,7 @@
 #include "../midishared/midifile.h"
 
 namespace mu::engraving {
+class EventMap;
 class Score;
 class TempoMap;
 class SynthesizerState;
@@ -53,9 +54,14 @@ private:
     //    MIDI files cannot contain pauses so need to insert
     //    extra ticks extra ticks and tempo changes instead.
     //---------------------------------------------------
-    class PauseMap : std::map<int, int>
+    class PauseMap
     {
+        // <utick, running total of extra ticks inserted up to it>, sorted by utick;
+        // a flat vector because it's looked up for every exported event
+        std::vector<std::pair<int, int> > m_offsets;
+
         int offsetAtUTick(int utick) const;
+        void insert(int utick, int offset);
 
     public:
         engraving::TempoMap* tempomapWithPauses = nullptr;
@@ -65,6 +71,7 @@ private:
     };
 
     void writeHeader();
+    void writeTracks(const engraving::EventMap& events, bool exportRPNs, std::vector<std::unique_ptr<MidiTrackStream> >& streams);
 
     QFile m_file;
     MidiFile m_midiFile;
@@ -249,6 +249,8 @@ static void setOperationsFromFile(const QString& fileName, Opers& opers)
 
 //-------------------------------------------------------------------------------------------
 
+thread_local int Data::_currentTrack = -1;
+
 FileData* Data::data()
 {
     const auto it = _data.find(_currentMidiFile);
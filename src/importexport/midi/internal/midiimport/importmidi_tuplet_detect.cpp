@@ -27,6 +27,7 @@
 #include "importmidi_inner.h"
 #include "importmidi_operations.h"
 
+#include <algorithm>
 #include <set>
 
 namespace mu::iex::midi {
@@ -204,14 +205,19 @@ TupletInfo findTupletApproximation(
         ReducedFraction regularError;
     };
 
-    std::multimap<Error, Candidate> chordCandidates;
+    // sorted by error after collecting; stable sort keeps candidates with equal errors
+    // in the order they were found, as the insertion into std::multimap did
+    std::vector<std::pair<Error, Candidate> > chordCandidates;
+    // tuplet note positions only increase, so chords before the current position range
+    // can't be candidates for the next positions either
+    auto firstChordIt = startChordIt;
 
     for (int posIndex = 0; posIndex != tupletNumber; ++posIndex) {
         const auto tupletNotePos = startTupletTime + tupletNoteLen * posIndex;
-        for (auto it = startChordIt; it != endChordIt; ++it) {
-            if (it->first < tupletNotePos - tupletNoteLen / 2) {
-                continue;
-            }
+        while (firstChordIt != endChordIt && firstChordIt->first < tupletNotePos - tupletNoteLen / 2) {
+            ++firstChordIt;
+        }
+        for (auto it = firstChordIt; it != endChordIt; ++it) {
             if (it->first > tupletNotePos + tupletNoteLen / 2) {
                 break;
             }
@@ -219,10 +225,15 @@ TupletInfo findTupletApproximation(
             const auto tupletError = (it->first - tupletNotePos).absValue();
             const auto regularError = Quantize::findOnTimeQuantError(*it, basicQuant);
             const auto diff = tupletError - regularError;
-            chordCandidates.insert({ { tupletError, diff }, { posIndex, it, regularError } });
+            chordCandidates.push_back({ { tupletError, diff }, { posIndex, it, regularError } });
         }
     }
 
+    std::stable_sort(chordCandidates.begin(), chordCandidates.end(),
+                     [](const std::pair<Error, Candidate>& c1, const std::pair<Error, Candidate>& c2) {
+        return c1.first < c2.first;
+    });
+
     std::set<std::pair<const ReducedFraction, MidiChord>*> usedChords;
     std::set<int> usedPosIndexes;
     ReducedFraction diffSum;
@@ -105,6 +105,49 @@ bool MidiFile::write(QIODevice* out)
     return false;
 }
 
+//---------------------------------------------------------
+//   write
+//    write already encoded tracks
+//    returns true on error
+//---------------------------------------------------------
+
+bool MidiFile::write(QIODevice* out, const std::vector<std::unique_ptr<MidiTrackStream> >& tracks)
+{
+    fp = out;
+    write("MThd", 4);
+    writeLong(6);                   // header len
+    writeShort(_format);            // format
+    writeShort(static_cast<int>(tracks.size()));
+    writeShort(_division);
+    for (const auto& t: tracks) {
+        write("MTrk", 4);
+        writeLong(t->data().size() + 4);   // track len, including "End Of Track" Meta
+        if (write(t->data().constData(), t->data().size())) {
+            return true;
+        }
+        putvl(1);
+        put(0xff);          // Meta
+        put(0x2f);          // EOT
+        putvl(0);           // len 0
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+//   writeEvent
+//    encode the event into the track stream
+//---------------------------------------------------------
+
+void MidiFile::writeEvent(MidiTrackStream& track, int tick, const MidiEvent& event)
+{
+    fp = &track._buffer;
+    status = track._status;
+    putvl(tick - track._tick);      // write tick delta
+    writeEvent(event);
+    track._tick = tick;
+    track._status = status;
+}
+
 //---------------------------------------------------------
 //   write
 //---------------------------------------------------------
@@ -519,6 +562,18 @@ MidiTrack::~MidiTrack()
 {
 }
 
+//---------------------------------------------------------
+//   MidiTrackStream
+//---------------------------------------------------------
+
+MidiTrackStream::MidiTrackStream()
+    : _buffer(&_data)
+{
+    _buffer.open(QIODevice::WriteOnly);
+    _tick = 0;
+    _status = -1;
+}
+
 //---------------------------------------------------------
 //   insert
 //---------------------------------------------------------
@@ -23,7 +23,9 @@
 #ifndef MIDISHARED_MIDIFILE_H
 #define MIDISHARED_MIDIFILE_H
 
+#include <memory>
 #include <vector>
+#include <QBuffer>
 #include <QIODevice>
 
 #include "../midishared/midievent.h"
@@ -69,6 +71,28 @@ public:
     void mergeNoteOnOffAndFindMidiType(MidiType* mt);
 };
 
+//---------------------------------------------------------
+//   MidiTrackStream
+//    events of a track encoded as soon as they are written,
+//    without keeping them in a MidiTrack;
+//    events must be written in tick order
+//---------------------------------------------------------
+
+class MidiTrackStream
+{
+    QByteArray _data;
+    QBuffer _buffer;
+    int _tick;
+    int _status;
+
+    friend class MidiFile;
+
+public:
+    MidiTrackStream();
+
+    const QByteArray& data() const { return _data; }
+};
+
 //---------------------------------------------------------
 //   MidiFile
 //---------------------------------------------------------
@@ -115,6 +139,8 @@ public:
     MidiFile();
     bool read(QIODevice*);
     bool write(QIODevice*);
+    bool write(QIODevice*, const std::vector<std::unique_ptr<MidiTrackStream> >& tracks);
+    void writeEvent(MidiTrackStream& track, int tick, const MidiEvent& event);
 
     std::vector<MidiTrack>& tracks() { return _tracks; }
     const std::vector<MidiTrack>& tracks() const { return _tracks; }
@@ -1614,6 +1614,10 @@ Err MusicXMLParserPass2::parse()
 
 void MusicXMLParserPass2::scorePartwise()
 {
+    buildMeasureIndex();
+
+    //! NOTE Parts are read one after another, not concurrently: all parts of a measure
+    //! share its segment list, and spanners, ties and linked elements are added through the score
     while (_e.readNextStartElement()) {
         if (_e.name() == "part") {
             part();
@@ -1634,6 +1638,38 @@ void MusicXMLParserPass2::scorePartwise()
     addError(checkAtEndElement(_e, "score-partwise"));
 }
 
+//---------------------------------------------------------
+//   buildMeasureIndex
+//---------------------------------------------------------
+
+/**
+ Index the measures created in pass 1 by start tick.
+ Every part looks up every measure, a linear search
+ makes pass 2 quadratic in the number of measures.
+ */
+
+void MusicXMLParserPass2::buildMeasureIndex()
+{
+    _measureIndex.clear();
+    for (Measure* m = _score->firstMeasure(); m; m = m->nextMeasure()) {
+        _measureIndex.emplace(m->tick(), m);
+    }
+}
+
+//---------------------------------------------------------
+//   findMeasure
+//---------------------------------------------------------
+
+/**
+ In the score find the measure starting at \a tick.
+ */
+
+Measure* MusicXMLParserPass2::findMeasure(const Fraction& tick) const
+{
+    const auto it = _measureIndex.find(tick);
+    return it != _measureIndex.end() ? it->second : nullptr;
+}
+
 //---------------------------------------------------------
 //   partList
 //---------------------------------------------------------
@@ -1801,24 +1837,6 @@ void MusicXMLParserPass2::part()
     addError(checkAtEndElement(_e, "part"));
 }
 
-//---------------------------------------------------------
-//   findMeasure
-//---------------------------------------------------------
-
-/**
- In Score \a score find the measure starting at \a tick.
- */
-
-static Measure* findMeasure(Score* score, const Fraction& tick)
-{
-    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
-        if (m->tick() == tick) {
-            return m;
-        }
-    }
-    return 0;
-}
-
 //---------------------------------------------------------
 //   removeBeam
 //---------------------------------------------------------
@@ -2038,7 +2056,7 @@ void MusicXMLParserPass2::measure(const QString& partId, const Fraction time)
 
     //LOGD("measure %d start", parsedMeasureNumber);
 
-    Measure* measure = findMeasure(_score, time);
+    Measure* measure = findMeasure(time);
     if (!measure) {
         _logger->logError(QString("measure at tick %1 not found!").arg(time.ticks()), &_e);
         skipLogCurrElem();
@@ -24,6 +24,7 @@
 #define __IMPORTMXMLPASS2_H__
 
 #include <array>
+#include <map>
 
 #include "importmxmlpass1.h"
 #include "importxmlfirstpass.h"
@@ -267,6 +268,8 @@ private:
     SpannerSet findIncompleteSpannersAtPartEnd();
     Err parse();
     void scorePartwise();
+    void buildMeasureIndex();
+    Measure* findMeasure(const Fraction& tick) const;
     void partList();
     void scorePart();
     void part();
@@ -314,6 +317,7 @@ private:
     MusicXMLParserPass1& _pass1;          // the pass1 results
     MxmlLogger* _logger;                  ///< Error logger
     QString _errors;                      ///< Errors to present to the user
+    std::map<Fraction, Measure*> _measureIndex;   ///< Measures created in pass 1, by start tick
 
     // part specific data (TODO: move to part-specific class)
 
@@ -44,19 +44,13 @@ const InstrumentTemplateList& InstrumentsRepository::instrumentTemplates() const
 
 const InstrumentTemplate& InstrumentsRepository::instrumentTemplate(const std::string& instrumentId) const
 {
-    const InstrumentTemplateList& templates = m_instrumentTemplates;
-
-    auto it = std::find_if(templates.begin(), templates.end(), [instrumentId](const InstrumentTemplate* templ) {
-        return templ->id == instrumentId;
-    });
-
-    if (it == m_instrumentTemplates.cend()) {
+    auto it = m_instrumentTemplatesById.find(String::fromStdString(instrumentId));
+    if (it == m_instrumentTemplatesById.cend()) {
         static InstrumentTemplate dummy;
         return dummy;
     }
 
-    const InstrumentTemplate* templ = *it;
-    return *templ;
+    return *it->second;
 }
 
 const ScoreOrderList& InstrumentsRepository::orders() const
@@ -95,6 +89,7 @@ void InstrumentsRepository::load()
     TRACEFUNC;
 
     m_instrumentTemplates.clear();
+    m_instrumentTemplatesById.clear();
     m_genres.clear();
     m_groups.clear();
     mu::engraving::clearInstrumentTemplates();
@@ -124,6 +119,7 @@ void InstrumentsRepository::load()
 
             templ->groupId = group->id;
             m_instrumentTemplates << templ;
+            m_instrumentTemplatesById.insert({ templ->id, templ });
         }
     }
 }
@@ -22,6 +22,8 @@
 #ifndef MU_NOTATION_INSTRUMENTSREPOSITORY_H
 #define MU_NOTATION_INSTRUMENTSREPOSITORY_H
 
+#include <unordered_map>
+
 #include "modularity/ioc.h"
 
 #include "async/channel.h"
@@ -52,6 +54,7 @@ private:
     void clear();
 
     InstrumentTemplateList m_instrumentTemplates;
+    std::unordered_map<String, const InstrumentTemplate*> m_instrumentTemplatesById;
     InstrumentGroupList m_groups;
     InstrumentGenreList m_genres;
 };
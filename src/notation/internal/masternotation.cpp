@@ -96,6 +96,13 @@ MasterNotation::MasterNotation()
     viewState()->needSaveChanged().onNotify(this, [this]() {
         notifyAboutNeedSaveChanged();
     });
+
+    engravingConfiguration()->undoHistoryLimitsChanged().onNotify(this, [this]() {
+        if (mu::engraving::MasterScore* score = masterScore()) {
+            score->undoStack()->setLimits(engravingConfiguration()->undoHistoryMaxSteps(),
+                                          engravingConfiguration()->undoHistoryMaxMemoryUsage());
+        }
+    });
 }
 
 MasterNotation::~MasterNotation()
@@ -42,6 +42,8 @@ class NotationProject;
 namespace mu::notation {
 class MasterNotation : public IMasterNotation, public Notation, public std::enable_shared_from_this<MasterNotation>
 {
+    INJECT(notation, engraving::IEngravingConfiguration, engravingConfiguration)
+
 public:
     ~MasterNotation();
 
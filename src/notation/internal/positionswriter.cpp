@@ -66,15 +66,13 @@ static void writeEventPosition(mu::framework::XmlWriter& writer, const std::stri
     writer.writeEndElement();
 }
 
-static void writeMeasureEvents(mu::framework::XmlWriter& writer, Measure* m, int offset, const QHash<void*, int>& segments)
+static void collectMeasureEvents(Measure* m, int offset, const QHash<void*, int>& segments, std::vector<int>& ids,
+                                 std::vector<int>& uticks)
 {
     for (mu::engraving::Segment* s = m->first(mu::engraving::SegmentType::ChordRest); s;
          s = s->next(mu::engraving::SegmentType::ChordRest)) {
-        int tick = s->tick().ticks() + offset;
-        int id = segments[(void*)s];
-        int time = lrint(m->score()->repeatList().utick2utime(tick) * 1000);
-
-        writeEventPosition(writer, std::to_string(id), time);
+        ids.push_back(segments[(void*)s]);
+        uticks.push_back(s->tick().ticks() + offset);
     }
 }
 
@@ -227,19 +225,20 @@ void PositionsWriter::writeEventsPositions(mu::framework::XmlWriter& writer, con
 
     score->masterScore()->setExpandRepeats(true);
 
+    //! NOTE Events follow the playback order, so their uticks are sorted and converted to times in one batch
+    std::vector<int> ids;
+    std::vector<int> uticks;
+
     for (const mu::engraving::RepeatSegment* repeatSegment : score->repeatList()) {
         int startTick = repeatSegment->tick;
         int endTick = startTick + repeatSegment->len();
         int tickOffset = repeatSegment->utick - repeatSegment->tick;
         for (Measure* measure = score->tick2measureMM(Fraction::fromTicks(startTick)); measure; measure = measure->nextMeasureMM()) {
             if (m_elementType == ElementType::SEGMENT) {
-                writeMeasureEvents(writer, measure, tickOffset, elementIds);
+                collectMeasureEvents(measure, tickOffset, elementIds, ids, uticks);
             } else {
-                int tick = measure->tick().ticks() + tickOffset;
-                int id = elementIds[(void*)measure];
-                int time = std::lrint(measure->score()->repeatList().utick2utime(tick) * 1000);
-
-                writeEventPosition(writer, std::to_string(id), time);
+                ids.push_back(elementIds[(void*)measure]);
+                uticks.push_back(measure->tick().ticks() + tickOffset);
             }
 
             if (measure->endTick().ticks() >= endTick) {
@@ -248,5 +247,10 @@ void PositionsWriter::writeEventsPositions(mu::framework::XmlWriter& writer, con
         }
     }
 
+    std::vector<double> utimes = score->repeatList().uticks2utimes(uticks);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        writeEventPosition(writer, std::to_string(ids[i]), std::lrint(utimes[i] * 1000));
+    }
+
     writer.writeEndElement();
 }
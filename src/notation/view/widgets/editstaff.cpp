@@ -319,10 +319,13 @@ void EditStaff::bboxClicked(QAbstractButton* button)
 
 void EditStaff::apply()
 {
-    size_t index = m_staff->score()->undoStack()->getCurIdx();
+    mu::engraving::UndoStack* undoStack = m_staff->score()->undoStack();
+    size_t index = undoStack->getCurIdx();
+    undoStack->setMergeStartIdx(index);
     applyStaffProperties();
     applyPartProperties();
-    m_staff->score()->undoStack()->mergeCommands(index);
+    undoStack->mergeCommands(index);
+    undoStack->resetMergeStartIdx();
 }
 
 void EditStaff::minPitchAClicked()
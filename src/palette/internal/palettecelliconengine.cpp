@@ -21,6 +21,11 @@
  */
 #include "palettecelliconengine.h"
 
+#include <algorithm>
+#include <mutex>
+
+#include <QCache>
+#include <QCoreApplication>
 #include <QPainter>
 
 #include "draw/types/geometry.h"
@@ -37,6 +42,16 @@ using namespace mu::palette;
 using namespace mu::draw;
 using namespace mu::engraving;
 
+static constexpr int ICONS_CACHE_MAX_COST_KB = 32 * 1024;
+static constexpr size_t PRERENDER_BATCH_SIZE = 16;
+
+//! NOTE Icons may be painted on the render thread of the Qt Quick scene graph,
+//! so images are cached rather than pixmaps, and the cache is guarded.
+//! The generation is part of the key, so an icon rendered before the cache was cleared is never found
+static std::mutex s_iconsCacheMutex;
+static QCache<QString, QImage> s_iconsCache(ICONS_CACHE_MAX_COST_KB);
+static int s_iconsCacheGeneration = 0;
+
 PaletteCellIconEngine::PaletteCellIconEngine(PaletteCellConstPtr cell, qreal extraMag)
     : QIconEngine(), m_cell(cell), m_extraMag(extraMag)
 {
@@ -49,12 +64,159 @@ QIconEngine* PaletteCellIconEngine::clone() const
 
 void PaletteCellIconEngine::paint(QPainter* qp, const QRect& rect, QIcon::Mode mode, QIcon::State state)
 {
+    if (rect.isEmpty()) {
+        return;
+    }
+
     qreal dpi = qp->device()->logicalDpiX();
-    Painter p(qp, "palettecell");
-    p.save();
-    p.setAntialiasing(true);
-    paintCell(p, RectF::fromQRectF(rect), mode == QIcon::Selected, state == QIcon::On, dpi);
-    p.restore();
+    qreal dpr = qp->device()->devicePixelRatioF();
+
+    startPendingPrerenders(dpr, dpi);
+
+    QImage image = cachedImage(rect.size(), dpr, dpi, mode == QIcon::Selected, state == QIcon::On);
+    qp->drawImage(rect.topLeft(), image);
+}
+
+void PaletteCellIconEngine::clearCache()
+{
+    std::lock_guard<std::mutex> lock(s_iconsCacheMutex);
+    s_iconsCache.clear();
+    ++s_iconsCacheGeneration;
+}
+
+struct PaletteCellIconEngine::PrerenderJob {
+    std::vector<PaletteCellConstPtr> cells;
+    size_t next = 0;
+    int generation = 0;
+    QSize size;
+    qreal extraMag = 1.0;
+    qreal dpi = 0.0;
+    qreal dpr = 1.0;
+};
+
+static std::vector<std::shared_ptr<PaletteCellIconEngine::PrerenderJob> > s_pendingPrerenders;
+
+void PaletteCellIconEngine::prerender(const std::vector<PaletteCellConstPtr>& cells, const QSize& size, qreal extraMag)
+{
+    if (cells.empty() || size.isEmpty()) {
+        return;
+    }
+
+    auto job = std::make_shared<PrerenderJob>();
+    job->cells = cells;
+    job->size = size;
+    job->extraMag = extraMag;
+
+    //! NOTE The icons must be rendered for the device they will be painted on,
+    //! which is only known once the palettes paint their first icon
+    std::lock_guard<std::mutex> lock(s_iconsCacheMutex);
+    job->generation = s_iconsCacheGeneration;
+    s_pendingPrerenders.push_back(job);
+}
+
+void PaletteCellIconEngine::startPendingPrerenders(qreal dpr, qreal dpi)
+{
+    std::vector<std::shared_ptr<PrerenderJob> > jobs;
+    {
+        std::lock_guard<std::mutex> lock(s_iconsCacheMutex);
+        if (s_pendingPrerenders.empty()) {
+            return;
+        }
+        jobs.swap(s_pendingPrerenders);
+    }
+
+    //! NOTE Icons may be painted on the render thread, rendering is done on the main thread
+    for (const std::shared_ptr<PrerenderJob>& job : jobs) {
+        job->dpr = dpr;
+        job->dpi = dpi;
+        QMetaObject::invokeMethod(qApp, [job]() {
+            prerenderBatch(job);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void PaletteCellIconEngine::prerenderBatch(std::shared_ptr<PrerenderJob> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(s_iconsCacheMutex);
+        if (job->generation != s_iconsCacheGeneration) {
+            return;
+        }
+    }
+
+    size_t end = std::min(job->next + PRERENDER_BATCH_SIZE, job->cells.size());
+    for (; job->next < end; ++job->next) {
+        PaletteCellIconEngine engine(job->cells[job->next], job->extraMag);
+        engine.cachedImage(job->size, job->dpr, job->dpi, false, false);
+    }
+
+    if (job->next < job->cells.size()) {
+        QMetaObject::invokeMethod(qApp, [job]() {
+            prerenderBatch(job);
+        }, Qt::QueuedConnection);
+    }
+}
+
+//! NOTE A cell is identified by its id, which is unique for the process. What it shows
+//! beyond its properties (the element content, the style and the fonts) is covered by the generation
+QString PaletteCellIconEngine::cacheKey(int generation, const QSize& size, qreal dpr, qreal dpi, bool selected, bool current) const
+{
+    QStringList key;
+    key.reserve(16);
+    key << QString::number(generation);
+    if (m_cell) {
+        key << m_cell->id
+            << QString::number(m_cell->mag)
+            << QString::number(m_cell->xoffset)
+            << QString::number(m_cell->yoffset)
+            << QString::number(m_cell->drawStaff);
+    }
+
+    key << QString::number(m_extraMag)
+        << QString::number(size.width())
+        << QString::number(size.height())
+        << QString::number(dpr)
+        << QString::number(dpi)
+        << QString::number(selected)
+        << QString::number(current)
+        << QString::number(configuration()->elementsColor().rgba(), 16)
+        << QString::number(configuration()->accentColor().rgba(), 16);
+
+    return key.join('|');
+}
+
+QImage PaletteCellIconEngine::cachedImage(const QSize& size, qreal dpr, qreal dpi, bool selected, bool current) const
+{
+    QString key;
+    int generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(s_iconsCacheMutex);
+        generation = s_iconsCacheGeneration;
+        key = cacheKey(generation, size, dpr, dpi, selected, current);
+        if (const QImage* image = s_iconsCache.object(key)) {
+            return *image;
+        }
+    }
+
+    QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
+
+    {
+        QPainter qp(&image);
+        Painter p(&qp, "palettecell");
+        p.setAntialiasing(true);
+        paintCell(p, RectF(0.0, 0.0, size.width(), size.height()), selected, current, dpi);
+    }
+
+    int costKb = std::max(1, static_cast<int>(image.sizeInBytes() / 1024));
+
+    std::lock_guard<std::mutex> lock(s_iconsCacheMutex);
+    if (generation == s_iconsCacheGeneration) {
+        s_iconsCache.insert(key, new QImage(image), costKb);
+    }
+
+    return image;
 }
 
 void PaletteCellIconEngine::paintCell(Painter& painter, const RectF& rect, bool selected, bool current, qreal dpi) const
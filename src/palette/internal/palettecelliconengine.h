@@ -23,6 +23,7 @@
 #define MU_PALETTE_PALETTECELLICONENGINE_H
 
 #include <QIconEngine>
+#include <QImage>
 
 #include "palettecell.h"
 
@@ -54,7 +55,24 @@ public:
 
     static void paintPaletteElement(void* context, mu::engraving::EngravingItem* element);
 
+    //! NOTE Rendered icons are cached, the cache must be cleared
+    //! when something not reflected in the cell properties changes (style, fonts, element content)
+    static void clearCache();
+
+    //! NOTE Renders icons of the cells into the cache in small batches when the event loop is idle,
+    //! so that the first scroll through the palettes doesn't have to render them.
+    //! Starts with the first painted icon, for the device it was painted on
+    static void prerender(const std::vector<PaletteCellConstPtr>& cells, const QSize& size, qreal extraMag);
+
+    struct PrerenderJob;
+
 private:
+    static void startPendingPrerenders(qreal dpr, qreal dpi);
+    static void prerenderBatch(std::shared_ptr<PrerenderJob> job);
+
+    QString cacheKey(int generation, const QSize& size, qreal dpr, qreal dpi, bool selected, bool current) const;
+    QImage cachedImage(const QSize& size, qreal dpr, qreal dpi, bool selected, bool current) const;
+
     void paintCell(draw::Painter& painter, const RectF& rect, bool selected, bool current, qreal dpi) const;
     void paintBackground(draw::Painter& painter, const RectF& rect, bool selected, bool current) const;
     void paintActionIcon(draw::Painter& painter, const RectF& rect, mu::engraving::EngravingItem* element) const;
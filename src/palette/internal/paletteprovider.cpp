@@ -33,6 +33,7 @@
 #include "libmscore/timesig.h"
 
 #include "palettecreator.h"
+#include "palettecelliconengine.h"
 #include "view/widgets/keyedit.h"
 #include "view/widgets/timedialog.h"
 
@@ -966,6 +967,30 @@ void PaletteProvider::setUserPaletteTree(PaletteTreePtr tree)
         m_userPaletteModel = new PaletteTreeModel(tree, /* parent */ this);
         connect(m_userPaletteModel, &PaletteTreeModel::treeChanged, this, &PaletteProvider::notifyAboutUserPaletteChanged);
     }
+
+    prerenderPaletteIcons(tree);
+}
+
+void PaletteProvider::prerenderPaletteIcons(PaletteTreePtr tree) const
+{
+    if (!tree) {
+        return;
+    }
+
+    for (const PalettePtr& palette : tree->palettes) {
+        if (!palette->isVisible() || !palette->isExpanded()) {
+            continue;
+        }
+
+        std::vector<PaletteCellConstPtr> cells;
+        for (const PaletteCellPtr& cell : palette->cells()) {
+            if (cell->visible) {
+                cells.push_back(cell);
+            }
+        }
+
+        PaletteCellIconEngine::prerender(cells, palette->scaledGridSize(), palette->mag() * configuration()->paletteScaling());
+    }
 }
 
 void PaletteProvider::setDefaultPaletteTree(PaletteTreePtr tree)
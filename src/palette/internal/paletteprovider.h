@@ -289,6 +289,8 @@ private:
 
     QString getPaletteFilename(bool open, const QString& name = "") const;
 
+    void prerenderPaletteIcons(PaletteTreePtr tree) const;
+
     PaletteTreeModel* m_userPaletteModel;
     PaletteTreeModel* m_masterPaletteModel;
     PaletteTreeModel* m_defaultPaletteModel; // palette used by "Reset palette" action
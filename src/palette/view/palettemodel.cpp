@@ -55,6 +55,14 @@ PaletteTreeModel::PaletteTreeModel(PaletteTreePtr tree, QObject* parent)
     connect(this, &QAbstractItemModel::rowsRemoved, this, &PaletteTreeModel::setTreeChanged);
 
     configuration()->colorsChanged().onNotify(this, [this]() {
+        PaletteCellIconEngine::clearCache();
+        notifyAboutCellsChanged(Qt::DecorationRole);
+    });
+
+    //! NOTE The palette score's style is only set on startup,
+    //! so fonts are the only other thing the icons depend on that can change
+    fontProvider()->fontsChanged().onNotify(this, [this]() {
+        PaletteCellIconEngine::clearCache();
         notifyAboutCellsChanged(Qt::DecorationRole);
     });
 }
@@ -79,6 +87,8 @@ void PaletteTreeModel::onDataChanged(const QModelIndex& topLeft, const QModelInd
     }
 
     if (treeChanged) {
+        //! NOTE Cell elements may have been changed in place
+        PaletteCellIconEngine::clearCache();
         setTreeChanged();
     }
 }
@@ -30,6 +30,7 @@
 
 #include "modularity/ioc.h"
 #include "ipaletteconfiguration.h"
+#include "draw/ifontprovider.h"
 #include "async/asyncable.h"
 
 namespace mu::engraving {
@@ -103,6 +104,7 @@ class PaletteTreeModel : public QAbstractItemModel, public mu::async::Asyncable
     Q_OBJECT
 
     INJECT(palette, IPaletteConfiguration, configuration)
+    INJECT(palette, draw::IFontProvider, fontProvider)
 
 public:
     enum PaletteTreeModelRoles {
@@ -21,12 +21,17 @@
  */
 
 #include "score.h"
+
+#include <algorithm>
+
 #include "cursor.h"
 #include "elements.h"
 
+#include "libmscore/chord.h"
 #include "libmscore/factory.h"
 #include "libmscore/instrtemplate.h"
 #include "libmscore/measure.h"
+#include "libmscore/note.h"
 #include "libmscore/score.h"
 #include "libmscore/segment.h"
 #include "libmscore/text.h"
@@ -43,6 +48,80 @@ Cursor* Score::newCursor()
     return new Cursor(score());
 }
 
+//---------------------------------------------------------
+//   Score::notes
+//---------------------------------------------------------
+
+QVariantMap Score::notes(int startTick, int endTick, int startStaff, int endStaff)
+{
+    mu::engraving::Score* s = score();
+
+    const int nstaves = static_cast<int>(s->nstaves());
+    startStaff = std::clamp(startStaff, 0, nstaves);
+    endStaff = (endStaff < 0) ? nstaves : std::clamp(endStaff, startStaff, nstaves);
+
+    const track_idx_t startTrack = static_cast<track_idx_t>(startStaff) * VOICES;
+    const track_idx_t endTrack = static_cast<track_idx_t>(endStaff) * VOICES;
+
+    QList<int> pitches;
+    QList<int> tpcs;
+    QList<int> tpcs1;
+    QList<int> tpcs2;
+    QList<int> ticks;
+    QList<int> durations;
+    QList<int> tracks;
+
+    auto appendNotes = [&](const mu::engraving::Chord* chord, int tick) {
+        const int duration = chord->actualTicks().ticks();
+        for (const mu::engraving::Note* note : chord->notes()) {
+            pitches.append(note->pitch());
+            tpcs.append(note->tpc());
+            tpcs1.append(note->tpc1());
+            tpcs2.append(note->tpc2());
+            ticks.append(tick);
+            durations.append(duration);
+            tracks.append(static_cast<int>(note->track()));
+        }
+    };
+
+    for (mu::engraving::Segment* seg = s->firstSegment(SegmentType::ChordRest); seg; seg = seg->next1(SegmentType::ChordRest)) {
+        const int tick = seg->tick().ticks();
+        if (tick < startTick) {
+            continue;
+        }
+        if (endTick >= 0 && tick >= endTick) {
+            break;
+        }
+
+        for (track_idx_t track = startTrack; track < endTrack; ++track) {
+            mu::engraving::EngravingItem* el = seg->element(track);
+            if (!el || !el->isChord()) {
+                continue;
+            }
+
+            const mu::engraving::Chord* chord = toChord(el);
+            for (const mu::engraving::Chord* grace : chord->graceNotesBefore()) {
+                appendNotes(grace, tick);
+            }
+            appendNotes(chord, tick);
+            for (const mu::engraving::Chord* grace : chord->graceNotesAfter()) {
+                appendNotes(grace, tick);
+            }
+        }
+    }
+
+    QVariantMap result;
+    result["pitch"] = QVariant::fromValue(pitches);
+    result["tpc"] = QVariant::fromValue(tpcs);
+    result["tpc1"] = QVariant::fromValue(tpcs1);
+    result["tpc2"] = QVariant::fromValue(tpcs2);
+    result["tick"] = QVariant::fromValue(ticks);
+    result["duration"] = QVariant::fromValue(durations);
+    result["track"] = QVariant::fromValue(tracks);
+
+    return result;
+}
+
 //---------------------------------------------------------
 //   Score::addText
 ///   \brief Adds a header text to the score.
@@ -204,6 +204,22 @@ public:
 
     Q_INVOKABLE QString extractLyrics() { return score()->extractLyrics(); }
 
+    /**
+     * Returns the notes of the given tick and staff range at once,
+     * without creating an object for each note. The result is an object
+     * of equally sized arrays: \p pitch, \p tpc, \p tpc1, \p tpc2, \p tick,
+     * \p duration and \p track, with one entry per note, ordered by tick and track.
+     * As for Note, \p tpc is the spelling currently displayed, \p tpc1 the concert
+     * pitch spelling and \p tpc2 the transposed spelling.
+     * Grace notes are reported at the tick of the chord they belong to.
+     * \param startTick - first tick of the range, inclusive.
+     * \param endTick - last tick of the range, exclusive, -1 for the end of the score.
+     * \param startStaff - first staff of the range, inclusive.
+     * \param endStaff - last staff of the range, exclusive, -1 for all staves.
+     * \since MuseScore 4.1
+     */
+    Q_INVOKABLE QVariantMap notes(int startTick = 0, int endTick = -1, int startStaff = 0, int endStaff = -1);
+
 //      //@ ??
 //      Q_INVOKABLE void updateRepeatList(bool expandRepeats) { score()->updateRepeatList(); } // TODO: needed?
 
@@ -62,6 +62,7 @@ public:
     virtual Ret canSave() const = 0;
 
     virtual Ret save(const io::path_t& path = io::path_t(), SaveMode saveMode = SaveMode::Save) = 0;
+    virtual void waitAutoSaveFinished() = 0;
     virtual Ret writeToDevice(QIODevice* device) = 0;
 
     virtual ProjectMeta metaInfo() const = 0;
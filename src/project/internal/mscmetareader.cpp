@@ -63,8 +63,11 @@ mu::RetVal<ProjectMeta> MscMetaReader::readMeta(const io::path_t& filePath) cons
     framework::XmlReader xmlReader(scoreData.toQByteArray());
     doReadMeta(xmlReader, meta.val);
 
-    // Read thumbnail
-    ByteArray thumbnailData = msczReader.readThumbnailFile();
+    // Read thumbnail, a cached one is more recent than the one in the file
+    ByteArray thumbnailData = thumbnailCache()->thumbnail(filePath);
+    if (thumbnailData.empty()) {
+        thumbnailData = msczReader.readThumbnailFile();
+    }
     if (thumbnailData.empty()) {
         LOGD() << "Can't find thumbnail";
     } else {
@@ -26,6 +26,7 @@
 
 #include "io/ifilesystem.h"
 #include "modularity/ioc.h"
+#include "iprojectthumbnailcache.h"
 
 namespace mu::framework {
 class XmlReader;
@@ -35,6 +36,7 @@ namespace mu::project {
 class MscMetaReader : public IMscMetaReader
 {
     INJECT(project, io::IFileSystem, fileSystem)
+    INJECT(project, IProjectThumbnailCache, thumbnailCache)
 
 public:
     RetVal<ProjectMeta> readMeta(const io::path_t& filePath) const;
@@ -21,6 +21,8 @@
  */
 #include "notationproject.h"
 
+#include <chrono>
+
 #include <QBuffer>
 #include <QDir>
 #include <QFile>
@@ -115,6 +117,8 @@ static QString scoreDefaultTitle()
 
 NotationProject::~NotationProject()
 {
+    waitAutoSaveFinished();
+
     m_projectAudioSettings = nullptr;
     m_masterNotation = nullptr;
     m_engravingProject = nullptr;
@@ -225,6 +229,11 @@ mu::Ret NotationProject::doLoad(engraving::MscReader& reader, const io::path_t&
     masterScore->setLayoutAll();
     masterScore->update();
 
+    //! NOTE The saved thumbnail is still valid as long as page 1 is laid out as it was saved
+    if (stylePath.empty() && masterScore->mscVersion() >= engraving::MSCVERSION) {
+        masterScore->setThumbnail(reader.readThumbnailFile());
+    }
+
     // Load other stuff from the project file
     ret = m_projectAudioSettings->read(reader);
     if (!ret) {
@@ -433,6 +442,10 @@ void NotationProject::setCloudInfo(const CloudProjectInfo& info)
 mu::Ret NotationProject::save(const io::path_t& path, SaveMode saveMode)
 {
     TRACEFUNC;
+
+    //! NOTE A save must not race with the files of the previous autosave still being written
+    waitAutoSaveFinished();
+
     switch (saveMode) {
     case SaveMode::SaveSelection:
         return saveSelectionOnScore(path);
@@ -459,6 +472,10 @@ mu::Ret NotationProject::save(const io::path_t& path, SaveMode saveMode)
                 setPath(savePath);
                 m_masterNotation->notation()->undoStack()->stackChanged().notify();
             }
+
+            if (suffix.empty() || isMuseScoreFile(suffix)) {
+                cacheThumbnail(savePath);
+            }
         }
 
         return ret;
@@ -474,7 +491,11 @@ mu::Ret NotationProject::save(const io::path_t& path, SaveMode saveMode)
             suffix = engraving::MSCX;
         }
 
-        return saveScore(path, suffix);
+        if (!isMuseScoreFile(suffix)) {
+            return saveScore(path, suffix);
+        }
+
+        return doAutoSave(path, mscIoModeBySuffix(suffix));
     }
 
     return make_ret(notation::Err::UnknownError);
@@ -520,6 +541,70 @@ mu::Ret NotationProject::saveScore(const io::path_t& path, const std::string& fi
     return doSave(path, true, ioMode);
 }
 
+static mu::Ret checkSavePath(const QString& targetContainerPath, const QString& savePath, engraving::MscIoMode ioMode)
+{
+    QFileInfo fi(savePath);
+    if (fi.exists() && !QFileInfo(savePath).isWritable()) {
+        LOGE() << "failed save, not writable path: " << savePath;
+        return make_ret(notation::Err::UnknownError);
+    }
+
+    if (ioMode == engraving::MscIoMode::Dir) {
+        // Dir needs to be created, otherwise we can't move to it
+        if (!QDir(targetContainerPath).mkpath(".")) {
+            LOGE() << "Couldn't create container directory";
+            return make_ret(notation::Err::UnknownError);
+        }
+    }
+
+    return make_ok();
+}
+
+static mu::Ret replaceSavedFile(std::shared_ptr<IFileSystem> fileSystem, const QString& savePath, const QString& targetContainerPath,
+                                const io::path_t& targetMainFilePath, engraving::MscIoMode ioMode)
+{
+    // Replace to saved file
+    {
+        if (ioMode == MscIoMode::Dir) {
+            RetVal<io::paths_t> filesToBeMoved = fileSystem->scanFiles(savePath, { "*" }, io::ScanMode::FilesAndFoldersInCurrentDir);
+            if (!filesToBeMoved.ret) {
+                return filesToBeMoved.ret;
+            }
+
+            Ret ret = make_ok();
+
+            for (const io::path_t& fileToBeMoved : filesToBeMoved.val) {
+                io::path_t destinationFile
+                    = io::path_t(targetContainerPath).appendingComponent(io::filename(fileToBeMoved));
+                LOGD() << fileToBeMoved << " to " << destinationFile;
+                ret = fileSystem->move(fileToBeMoved, destinationFile, true);
+                if (!ret) {
+                    return ret;
+                }
+            }
+
+            // Try to remove the temp save folder (not problematic if fails)
+            ret = fileSystem->remove(savePath, true);
+            if (!ret) {
+                LOGW() << ret.toString();
+            }
+        } else {
+            Ret ret = fileSystem->move(savePath, targetContainerPath, true);
+            if (!ret) {
+                return ret;
+            }
+        }
+    }
+
+    // make file readable by all
+    {
+        QFile::setPermissions(targetMainFilePath.toQString(),
+                              QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::ReadGroup | QFile::ReadOther);
+    }
+
+    return make_ok();
+}
+
 mu::Ret NotationProject::doSave(const io::path_t& path, bool generateBackup, engraving::MscIoMode ioMode)
 {
     QString targetContainerPath = engraving::containerPath(path).toQString();
@@ -529,18 +614,9 @@ mu::Ret NotationProject::doSave(const io::path_t& path, bool generateBackup, eng
 
     // Step 1: check writable
     {
-        QFileInfo fi(savePath);
-        if (fi.exists() && !QFileInfo(savePath).isWritable()) {
-            LOGE() << "failed save, not writable path: " << savePath;
-            return make_ret(notation::Err::UnknownError);
-        }
-
-        if (ioMode == engraving::MscIoMode::Dir) {
-            // Dir needs to be created, otherwise we can't move to it
-            if (!QDir(targetContainerPath).mkpath(".")) {
-                LOGE() << "Couldn't create container directory";
-                return make_ret(notation::Err::UnknownError);
-            }
+        Ret ret = checkSavePath(targetContainerPath, savePath, ioMode);
+        if (!ret) {
+            return ret;
         }
     }
 
@@ -554,6 +630,8 @@ mu::Ret NotationProject::doSave(const io::path_t& path, bool generateBackup, eng
             return make_ret(Ret::Code::InternalError);
         }
 
+        //! NOTE Page 1 is only rendered again if its layout changed since the thumbnail was made,
+        //! the file and the thumbnail cache get the same image, see cacheThumbnail()
         MscWriter msczWriter(params);
         Ret ret = writeProject(msczWriter, false);
         if (!ret) {
@@ -573,47 +651,100 @@ mu::Ret NotationProject::doSave(const io::path_t& path, bool generateBackup, eng
 
     // Step 4: replace to saved file
     {
-        if (ioMode == MscIoMode::Dir) {
-            RetVal<io::paths_t> filesToBeMoved = fileSystem()->scanFiles(savePath, { "*" }, io::ScanMode::FilesAndFoldersInCurrentDir);
-            if (!filesToBeMoved.ret) {
-                return filesToBeMoved.ret;
-            }
+        Ret ret = replaceSavedFile(fileSystem(), savePath, targetContainerPath, targetMainFilePath, ioMode);
+        if (!ret) {
+            return ret;
+        }
+    }
 
-            Ret ret = make_ok();
+    LOGI() << "success save file: " << targetContainerPath;
+    return make_ret(Ret::Code::Ok);
+}
 
-            for (const io::path_t& fileToBeMoved : filesToBeMoved.val) {
-                io::path_t destinationFile
-                    = io::path_t(targetContainerPath).appendingComponent(io::filename(fileToBeMoved));
-                LOGD() << fileToBeMoved << " to " << destinationFile;
-                ret = fileSystem()->move(fileToBeMoved, destinationFile, true);
-                if (!ret) {
-                    return ret;
-                }
-            }
+mu::Ret NotationProject::doAutoSave(const io::path_t& path, engraving::MscIoMode ioMode)
+{
+    TRACEFUNC;
 
-            // Try to remove the temp save folder (not problematic if fails)
-            ret = fileSystem()->remove(savePath, true);
-            if (!ret) {
-                LOGW() << ret.toString();
-            }
-        } else {
-            Ret ret = fileSystem()->move(savePath, targetContainerPath, true);
-            if (!ret) {
-                return ret;
-            }
-        }
+    waitAutoSaveFinished();
+
+    auto snapshotStart = std::chrono::steady_clock::now();
+
+    QString targetContainerPath = engraving::containerPath(path).toQString();
+    io::path_t targetMainFilePath = engraving::mainFilePath(path);
+    io::path_t targetMainFileName = engraving::mainFileName(path);
+    QString savePath = targetContainerPath + "_saving";
+
+    Ret ret = checkSavePath(targetContainerPath, savePath, ioMode);
+    if (!ret) {
+        return ret;
     }
 
-    // make file readable by all
-    {
-        QFile::setPermissions(targetMainFilePath.toQString(),
-                              QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::ReadGroup | QFile::ReadOther);
+    //! NOTE Only the serialisation into memory happens here, it is a consistent snapshot of the project.
+    //! Compression and disk IO are done on a background thread. An autosave never replaces the project
+    //! file itself, so there is no backup to make, and autosaves have no thumbnail
+    MscWriter::Params params;
+    params.filePath = savePath;
+    params.mainFileName = targetMainFileName.toQString();
+    params.mode = ioMode;
+    params.deferred = true;
+    IF_ASSERT_FAILED(params.mode != MscIoMode::Unknown) {
+        return make_ret(Ret::Code::InternalError);
     }
 
-    LOGI() << "success save file: " << targetContainerPath;
+    auto msczWriter = std::make_shared<MscWriter>(params);
+    ret = writeProject(*msczWriter, false, false);
+    if (!ret) {
+        LOGE() << "failed write project to buffer";
+        return ret;
+    }
+
+    auto snapshotTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - snapshotStart);
+    LOGI() << "[autosave] snapshot taken in " << snapshotTime.count() << " ms";
+
+    auto writeSnapshot = [msczWriter, fileSystem = fileSystem(), savePath, targetContainerPath, targetMainFilePath, ioMode]() {
+        if (!msczWriter->commit()) {
+            LOGE() << "[autosave] failed write project: " << savePath;
+            return;
+        }
+
+        Ret ret = replaceSavedFile(fileSystem, savePath, targetContainerPath, targetMainFilePath, ioMode);
+        if (!ret) {
+            LOGE() << "[autosave] failed replace file, err: " << ret.toString();
+            return;
+        }
+
+        LOGI() << "[autosave] success save file: " << targetContainerPath;
+    };
+
+#ifdef Q_OS_WASM
+    writeSnapshot();
+#else
+    m_autoSaveThread = std::thread(writeSnapshot);
+#endif
+
     return make_ret(Ret::Code::Ok);
 }
 
+void NotationProject::cacheThumbnail(const io::path_t& savedPath)
+{
+    const ByteArray& thumbnail = m_masterNotation->masterScore()->thumbnail();
+    if (thumbnail.empty()) {
+        return;
+    }
+
+    Ret ret = thumbnailCache()->setThumbnail(savedPath, thumbnail);
+    if (!ret) {
+        LOGE() << "failed cache thumbnail, err: " << ret.toString();
+    }
+}
+
+void NotationProject::waitAutoSaveFinished()
+{
+    if (m_autoSaveThread.joinable()) {
+        m_autoSaveThread.join();
+    }
+}
+
 mu::Ret NotationProject::makeCurrentFileAsBackup()
 {
     if (isNewlyCreated()) {
@@ -654,7 +785,7 @@ mu::Ret NotationProject::makeCurrentFileAsBackup()
     return ret;
 }
 
-mu::Ret NotationProject::writeProject(MscWriter& msczWriter, bool onlySelection)
+mu::Ret NotationProject::writeProject(MscWriter& msczWriter, bool onlySelection, bool createThumbnail)
 {
     // Create MsczWriter
     bool ok = msczWriter.open();
@@ -664,7 +795,7 @@ mu::Ret NotationProject::writeProject(MscWriter& msczWriter, bool onlySelection)
     }
 
     // Write engraving project
-    ok = m_engravingProject->writeMscz(msczWriter, onlySelection, true);
+    ok = m_engravingProject->writeMscz(msczWriter, onlySelection, createThumbnail);
     if (!ok) {
         LOGE() << "failed write engraving project to mscz";
         return make_ret(notation::Err::UnknownError);
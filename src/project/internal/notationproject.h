@@ -22,6 +22,8 @@
 #ifndef MU_PROJECT_NOTATIONPROJECT_H
 #define MU_PROJECT_NOTATIONPROJECT_H
 
+#include <thread>
+
 #include "../inotationproject.h"
 
 #include "async/asyncable.h"
@@ -29,6 +31,7 @@
 #include "modularity/ioc.h"
 #include "io/ifilesystem.h"
 #include "iprojectconfiguration.h"
+#include "iprojectthumbnailcache.h"
 #include "inotationreadersregister.h"
 #include "inotationwritersregister.h"
 
@@ -54,6 +57,7 @@ class NotationProject : public INotationProject, public async::Asyncable
     INJECT(project, INotationReadersRegister, readers)
     INJECT(project, INotationWritersRegister, writers)
     INJECT(project, IProjectMigrator, migrator)
+    INJECT(project, IProjectThumbnailCache, thumbnailCache)
 
 public:
     ~NotationProject() override;
@@ -83,6 +87,7 @@ public:
     Ret canSave() const override;
 
     Ret save(const io::path_t& path = io::path_t(), SaveMode saveMode = SaveMode::Save) override;
+    void waitAutoSaveFinished() override;
     Ret writeToDevice(QIODevice* device) override;
 
     ProjectMeta metaInfo() const override;
@@ -103,8 +108,10 @@ private:
     Ret saveSelectionOnScore(const io::path_t& path = io::path_t());
     Ret exportProject(const io::path_t& path, const std::string& suffix);
     Ret doSave(const io::path_t& path, bool generateBackup, engraving::MscIoMode ioMode);
+    Ret doAutoSave(const io::path_t& path, engraving::MscIoMode ioMode);
+    void cacheThumbnail(const io::path_t& savedPath);
     Ret makeCurrentFileAsBackup();
-    Ret writeProject(engraving::MscWriter& msczWriter, bool onlySelection);
+    Ret writeProject(engraving::MscWriter& msczWriter, bool onlySelection, bool createThumbnail = true);
 
     mu::engraving::EngravingProjectPtr m_engravingProject = nullptr;
     notation::IMasterNotationPtr m_masterNotation = nullptr;
@@ -118,6 +125,8 @@ private:
 
     bool m_isNewlyCreated = false; /// true if the file has never been saved yet
     bool m_isImported = false;
+
+    std::thread m_autoSaveThread;
 };
 }
 
@@ -1082,8 +1082,7 @@ void ProjectActionsController::revertCorruptedScoreToLastSaved()
 
     bool hasUnsavedChanges = projectAutoSaver()->projectHasUnsavedChanges(filePath);
     if (hasUnsavedChanges) {
-        io::path_t autoSavePath = projectAutoSaver()->projectAutoSavePath(filePath);
-        fileSystem()->remove(autoSavePath);
+        projectAutoSaver()->removeProjectUnsavedChanges(filePath);
     }
 
     Ret ret = doOpenProject(filePath);
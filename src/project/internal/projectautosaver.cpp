@@ -85,6 +85,11 @@ bool ProjectAutoSaver::projectHasUnsavedChanges(const io::path_t& projectPath) c
 
 void ProjectAutoSaver::removeProjectUnsavedChanges(const io::path_t& projectPath)
 {
+    //! NOTE An autosave still being written would bring the removed files back
+    if (auto project = currentProject()) {
+        project->waitAutoSaveFinished();
+    }
+
     io::path_t path = projectPath;
     if (!isAutosaveOfNewlyCreatedProject(projectPath)) {
         path = projectAutoSavePath(projectPath);
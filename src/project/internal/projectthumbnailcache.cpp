@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "projectthumbnailcache.h"
+
+#include <QCryptographicHash>
+#include <QFileInfo>
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::project;
+
+ByteArray ProjectThumbnailCache::thumbnail(const io::path_t& projectPath) const
+{
+    io::path_t path = cachePath(projectPath);
+    if (!fileSystem()->exists(path)) {
+        return ByteArray();
+    }
+
+    //! NOTE The project was saved after the thumbnail was cached, so it is stale
+    QFileInfo cacheInfo(path.toQString());
+    if (cacheInfo.lastModified() < QFileInfo(projectPath.toQString()).lastModified()) {
+        return ByteArray();
+    }
+
+    RetVal<ByteArray> data = fileSystem()->readFile(path);
+    if (!data.ret) {
+        LOGE() << "failed read thumbnail: " << path << ", err: " << data.ret.toString();
+        return ByteArray();
+    }
+
+    return data.val;
+}
+
+Ret ProjectThumbnailCache::setThumbnail(const io::path_t& projectPath, const ByteArray& png)
+{
+    io::path_t path = cachePath(projectPath);
+
+    Ret ret = fileSystem()->makePath(io::dirpath(path));
+    if (!ret) {
+        return ret;
+    }
+
+    return fileSystem()->writeFile(path, png);
+}
+
+io::path_t ProjectThumbnailCache::cachePath(const io::path_t& projectPath) const
+{
+    QByteArray key = fileSystem()->absoluteFilePath(projectPath).toQString().toUtf8();
+    QString name = QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex();
+
+    return globalConfiguration()->userAppDataPath() + "/thumbnails/" + name + ".png";
+}
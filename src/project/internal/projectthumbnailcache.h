@@ -0,0 +1,46 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_PROJECT_PROJECTTHUMBNAILCACHE_H
+#define MU_PROJECT_PROJECTTHUMBNAILCACHE_H
+
+#include "modularity/ioc.h"
+#include "global/iglobalconfiguration.h"
+#include "io/ifilesystem.h"
+
+#include "../iprojectthumbnailcache.h"
+
+namespace mu::project {
+class ProjectThumbnailCache : public IProjectThumbnailCache
+{
+    INJECT(project, framework::IGlobalConfiguration, globalConfiguration)
+    INJECT(project, io::IFileSystem, fileSystem)
+
+public:
+    ByteArray thumbnail(const io::path_t& projectPath) const override;
+    Ret setThumbnail(const io::path_t& projectPath, const ByteArray& png) override;
+
+private:
+    io::path_t cachePath(const io::path_t& projectPath) const;
+};
+}
+
+#endif // MU_PROJECT_PROJECTTHUMBNAILCACHE_H
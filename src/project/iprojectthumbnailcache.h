@@ -0,0 +1,46 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_PROJECT_IPROJECTTHUMBNAILCACHE_H
+#define MU_PROJECT_IPROJECTTHUMBNAILCACHE_H
+
+#include "io/path.h"
+#include "types/bytearray.h"
+#include "types/ret.h"
+
+#include "modularity/imoduleexport.h"
+
+namespace mu::project {
+//! NOTE Thumbnails kept outside the project files, so that they can be refreshed
+//! without saving the project again. An entry is only valid while it is newer than the project file
+class IProjectThumbnailCache : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IProjectThumbnailCache)
+
+public:
+    virtual ~IProjectThumbnailCache() = default;
+
+    virtual ByteArray thumbnail(const io::path_t& projectPath) const = 0;
+    virtual Ret setThumbnail(const io::path_t& projectPath, const ByteArray& png) = 0;
+};
+}
+
+#endif // MU_PROJECT_IPROJECTTHUMBNAILCACHE_H
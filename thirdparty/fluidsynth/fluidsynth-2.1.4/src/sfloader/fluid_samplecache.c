@@ -75,29 +75,44 @@ int fluid_samplecache_load(SFData *sf,
                            int try_mlock, short **sample_data, char **sample_data24)
 {
     fluid_samplecache_entry_t *entry;
+    fluid_samplecache_entry_t *new_entry = NULL;
     int ret;
     time_t mtime;
 
-    fluid_mutex_lock(samplecache_mutex);
-
     if(fluid_get_file_modification_time(sf->fname, &mtime) == FLUID_FAILED)
     {
         mtime = 0;
     }
 
+    fluid_mutex_lock(samplecache_mutex);
+
     entry = get_samplecache_entry(sf, sample_start, sample_end, sample_type, mtime);
 
     if(entry == NULL)
     {
-        entry = new_samplecache_entry(sf, sample_start, sample_end, sample_type, mtime);
+        /* MuseScore: read (and for SF3 decode) the sample outside of the cache lock,
+         * so a thread loading samples doesn't block other threads taking or releasing
+         * already cached ones. Only publishing the new entry happens under the lock. */
+        fluid_mutex_unlock(samplecache_mutex);
 
-        if(entry == NULL)
+        new_entry = new_samplecache_entry(sf, sample_start, sample_end, sample_type, mtime);
+
+        if(new_entry == NULL)
         {
-            ret = -1;
-            goto unlock_exit;
+            return -1;
         }
 
-        samplecache_list = fluid_list_prepend(samplecache_list, entry);
+        fluid_mutex_lock(samplecache_mutex);
+
+        /* Another thread may have published the same sample meanwhile */
+        entry = get_samplecache_entry(sf, sample_start, sample_end, sample_type, mtime);
+
+        if(entry == NULL)
+        {
+            entry = new_entry;
+            new_entry = NULL;
+            samplecache_list = fluid_list_prepend(samplecache_list, entry);
+        }
     }
 
     if(try_mlock && !entry->mlocked)
@@ -128,8 +143,11 @@ int fluid_samplecache_load(SFData *sf,
     *sample_data24 = entry->sample_data24;
     ret = entry->sample_count;
 
-unlock_exit:
     fluid_mutex_unlock(samplecache_mutex);
+
+    /* Lost the race for publishing, the duplicate is not needed */
+    delete_samplecache_entry(new_entry);
+
     return ret;
 }
 